@@ -36,19 +36,12 @@ public:
     {
     }
 
-    AppInfo(const AppInfo &info)
-    : m_desktop(info.m_desktop)
-    , m_name(info.m_name)
-    , m_key(info.m_key)
-    , m_iconKey(info.m_iconKey)
-    , m_status(info.m_status)
-    , m_categoryId(info.m_categoryId)
-    , m_description(info.m_description)
-    , m_progressValue(info.m_progressValue)
-    {
-    }
+    AppInfo(const AppInfo &info) = default;
+    AppInfo(AppInfo &&info) = default;
+    ~AppInfo() = default;
 
-    ~AppInfo() {}
+    AppInfo &operator=(const AppInfo &info) = default;
+    AppInfo &operator=(AppInfo &&info) = default;
 
     static void registerMetaType()
     {
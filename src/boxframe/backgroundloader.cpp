@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundloader.h"
+#include "blurengine.h"
+
+#include <QDebug>
+#include <QCache>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QImageReader>
+#include <QtConcurrent>
+
+static const QString DefaultWallpaper = "/usr/share/backgrounds/default_background.jpg";
+
+// 缓存上限(字节), 约可容纳两张 4K 壁纸及若干模糊背景
+static const int MAX_BACKGROUND_CACHE_COST = 96 * 1024 * 1024;
+
+// 模糊背景只需要较低的分辨率解码
+static const int BLUR_DECODE_SCALE = 4;
+
+static QCache<QString, QImage> &backgroundCache()
+{
+    static QCache<QString, QImage> cache(MAX_BACKGROUND_CACHE_COST);
+    return cache;
+}
+
+BackgroundLoader::BackgroundLoader(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief BackgroundLoader::loadImage 加载缩放到指定大小的壁纸, 命中缓存时直接发送 imageLoaded 信号, 否则在工作线程中处理
+ * @param path 壁纸路径
+ * @param size 目标大小(物理像素)
+ * @param type 原始壁纸或本地模糊后的壁纸
+ */
+void BackgroundLoader::loadImage(const QString &path, const QSize &size, const ImageType type)
+{
+    const QString key = cacheKey(path, size, type);
+
+    const QImage *cachedImage = backgroundCache().object(key);
+    if (cachedImage) {
+        emit imageLoaded(path, size, type, *cachedImage);
+        return;
+    }
+
+    if (m_pendingKeys.contains(key))
+        return;
+
+    m_pendingKeys.insert(key);
+
+    QFutureWatcher<QImage> *imageWatcher = new QFutureWatcher<QImage>(this);
+    connect(imageWatcher, &QFutureWatcher<QImage>::finished, this, [ = ] {
+        imageWatcher->deleteLater();
+        m_pendingKeys.remove(key);
+
+        const QImage image = imageWatcher->result();
+        if (image.isNull())
+            return;
+
+        backgroundCache().insert(key, new QImage(image), int(image.sizeInBytes()));
+        emit imageLoaded(path, size, type, image);
+    });
+
+    if (type == Blur)
+        imageWatcher->setFuture(QtConcurrent::run(&BackgroundLoader::loadBlurImage, path, size));
+    else
+        imageWatcher->setFuture(QtConcurrent::run(&BackgroundLoader::loadScaledImage, path, size));
+}
+
+/**
+ * @brief BackgroundLoader::loadScaledImage 按保持宽高比铺满的方式直接以目标分辨率解码图片, 路径无效时使用默认壁纸
+ * @param path 图片路径
+ * @param size 目标大小
+ * @return 缩放后的图片
+ */
+QImage BackgroundLoader::loadScaledImage(const QString &path, const QSize &size)
+{
+    QImageReader reader(path);
+    if (!reader.canRead())
+        reader.setFileName(DefaultWallpaper);
+
+    reader.setAutoTransform(true);
+
+    // 解码器支持时直接输出目标尺寸, 不支持时 read 之后再缩放
+    // scaledSize 作用于旋转前的图片, 需旋转 90 度的图片按旋转后的宽高计算再转置回去
+    const bool transposed = reader.transformation() & QImageIOHandler::TransformationRotate90;
+    QSize imageSize = reader.size();
+    QSize targetSize;
+    if (imageSize.isValid()) {
+        if (transposed)
+            imageSize.transpose();
+
+        targetSize = imageSize.scaled(size, Qt::KeepAspectRatioByExpanding);
+        reader.setScaledSize(transposed ? targetSize.transposed() : targetSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "read background failed:" << reader.fileName() << reader.errorString();
+        return image;
+    }
+
+    if (image.size() != targetSize)
+        image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+
+    return image;
+}
+
+/**
+ * @brief BackgroundLoader::loadBlurImage 以较低分辨率解码壁纸, 在本地模糊压暗后放大到目标大小
+ * @param path 图片路径
+ * @param size 目标大小
+ * @return 模糊压暗后的图片
+ */
+QImage BackgroundLoader::loadBlurImage(const QString &path, const QSize &size)
+{
+    const QImage sample = loadScaledImage(path, size / BLUR_DECODE_SCALE);
+    return BlurEngine::effectImage(sample, size);
+}
+
+QString BackgroundLoader::cacheKey(const QString &path, const QSize &size, const ImageType type)
+{
+    const qint64 lastModified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+    return QString("%1_%2_%3x%4_%5").arg(path).arg(lastModified).arg(size.width()).arg(size.height()).arg(type);
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDLOADER_H
+#define BACKGROUNDLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QSet>
+
+/**
+ * @brief The BackgroundLoader class
+ * 在工作线程中按目标分辨率解码壁纸或生成模糊背景, 结果按(路径, 修改时间, 大小, 类型)缓存
+ */
+class BackgroundLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum ImageType {
+        Normal,                                             // 原始壁纸
+        Blur                                                // 本地模糊压暗后的壁纸
+    };
+
+    explicit BackgroundLoader(QObject *parent = nullptr);
+
+    void loadImage(const QString &path, const QSize &size, const ImageType type = Normal);
+
+    static QImage loadScaledImage(const QString &path, const QSize &size);
+    static QImage loadBlurImage(const QString &path, const QSize &size);
+
+signals:
+    void imageLoaded(const QString &path, const QSize &size, const BackgroundLoader::ImageType type, const QImage &image);
+
+private:
+    static QString cacheKey(const QString &path, const QSize &size, const ImageType type);
+
+private:
+    QSet<QString> m_pendingKeys;                            // 正在加载中的图片, 避免重复加载
+};
+
+#endif // BACKGROUNDLOADER_H
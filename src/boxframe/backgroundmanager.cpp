@@ -3,15 +3,22 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "backgroundmanager.h"
+#include "backgroundloader.h"
 #include "appsmanager.h"
 
 #include <QApplication>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDBusPendingCallWatcher>
 #include <QtConcurrent>
 
 using namespace com::deepin;
 
 static const QString DefaultWallpaper = "/usr/share/backgrounds/default_background.jpg";
 
+// 空闲时每隔一段时间预处理一个(显示器, 工作区)的背景
+static const int PRECOMPUTE_INTERVAL = 1000;
+
 static QString getLocalFile(const QString &file)
 {
     const QUrl url(file);
@@ -36,6 +43,8 @@ void DisplayHelper::updateDisplayMode()
 BackgroundManager::BackgroundManager(QObject *parent)
     : QObject(parent)
     , m_currentWorkspace(-1)
+    , m_precomputeTimer(new QTimer(this))
+    , m_bgLoader(new BackgroundLoader(this))
     , m_wmInter(new wm("com.deepin.wm", "/com/deepin/wm", QDBusConnection::sessionBus(), this))
     , m_imageEffectInter(new ImageEffectInter("org.deepin.dde.ImageEffect1", "/org/deepin/dde/ImageEffect1", QDBusConnection::systemBus(), this))
     , m_imageblur(new ImageEffeblur("org.deepin.dde.ImageEffect1", "/org/deepin/dde/ImageBlur1", QDBusConnection::systemBus(), this))
@@ -47,8 +56,16 @@ BackgroundManager::BackgroundManager(QObject *parent)
 
     m_displayMode = m_displayInter->GetRealDisplayMode();
 
-    connect(m_wmInter, &__wm::WorkspaceSwitched, this, &BackgroundManager::updateBlurBackgrounds);
-    connect(m_wmInter, &__wm::WorkspaceBackgroundChanged, this, &BackgroundManager::updateBlurBackgrounds);
+    m_precomputeTimer->setSingleShot(true);
+    m_precomputeTimer->setInterval(PRECOMPUTE_INTERVAL);
+
+    connect(m_precomputeTimer, &QTimer::timeout, this, &BackgroundManager::precomputeNext);
+    connect(m_wmInter, &__wm::WorkspaceSwitched, this, &BackgroundManager::onWorkspaceSwitched);
+    connect(m_wmInter, &__wm::WorkspaceBackgroundChanged, this, &BackgroundManager::onWorkspaceBackgroundChanged);
+    connect(m_wmInter, &__wm::WorkspaceBackgroundChangedForMonitor, this, &BackgroundManager::onWorkspaceBackgroundChangedForMonitor);
+    connect(m_wmInter, &__wm::workspaceCountChanged, this, &BackgroundManager::schedulePrecompute);
+    connect(qApp, &QGuiApplication::screenAdded, this, &BackgroundManager::schedulePrecompute);
+    connect(qApp, &QGuiApplication::screenRemoved, this, &BackgroundManager::schedulePrecompute);
     connect(m_appearanceInter, &AppearanceInter::Changed, this, &BackgroundManager::onAppearanceChanged);
     connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &BackgroundManager::onDisplayModeChanged);
     connect(m_displayInter, &DisplayInter::PrimaryChanged, this, &BackgroundManager::onPrimaryChanged);
@@ -56,33 +73,98 @@ BackgroundManager::BackgroundManager(QObject *parent)
 
     connect(m_imageblur, &ImageEffeblur::BlurDone, this, &BackgroundManager::onGetBlurImageFromDbus);
 
+    // 当前工作区只在启动时获取一次, 之后由 WorkspaceSwitched 信号维护
+    QDBusPendingCallWatcher *workspaceWatcher = new QDBusPendingCallWatcher(m_wmInter->GetCurrentWorkspace(), this);
+    connect(workspaceWatcher, &QDBusPendingCallWatcher::finished, this, [this, workspaceWatcher] {
+        workspaceWatcher->deleteLater();
+
+        const QDBusPendingReply<int> reply = *workspaceWatcher;
+        if (reply.isError() || m_currentWorkspace > 0)
+            return;
+
+        m_currentWorkspace = reply.value();
+        updateBlurBackgrounds();
+        schedulePrecompute();
+    });
+
     updateBlurBackgrounds();
 }
 
-void BackgroundManager::getImageDataFromDbus(const QString &filePath)
+/**
+ * @brief BackgroundManager::getImageDataFromDbus 获取壁纸对应的全屏背景及模糊背景, 结果写入缓存
+ * @param filePath 原始壁纸路径
+ * @param key 缓存键, 只有与当前显示器及工作区一致时才发送背景变化信号
+ */
+void BackgroundManager::getImageDataFromDbus(const QString &filePath, const QString &key)
 {
+    if (!key.isEmpty()) {
+        WorkspaceBackground cache = m_backgroundCache.value(key);
+        cache.wallpaper = filePath;
+        cache.lastModified = QFileInfo(filePath).lastModified().toMSecsSinceEpoch();
+        cache.background.clear();
+        cache.blurBackground.clear();
+        m_backgroundCache.insert(key, cache);
+    }
+
+    // 系统总线上没有模糊服务时, 直接使用原始壁纸并在本地生成模糊背景
+    if (!effectServiceValid()) {
+        if (WorkspaceBackground *cache = cacheEntry(key, filePath)) {
+            cache->background = filePath;
+            cache->blurBackground = filePath;
+            cache->localBlur = true;
+            warmImageCache(key);
+        }
+
+        if (key != m_currentKey)
+            return;
+
+        m_background = filePath;
+        m_blurBackground = filePath;
+        emit currentWorkspaceBackgroundChanged(m_background);
+        emit currentWorkspaceLocalBlurBackgroundChanged(m_blurBackground);
+        return;
+    }
+
     // 异步获取模糊以及pixmix算法处理后的桌面背景(分类模式的视图背景)
     QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-    connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
+    connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher, filePath, key]{
         imageEffectWatcher->deleteLater();
-        m_blurBackground = imageEffectWatcher->result();
-        if (!m_blurBackground.isEmpty())
+        QString blurBackground = imageEffectWatcher->result();
+
+        // 服务处理失败时返回空路径, 改为本地模糊
+        const bool localBlur = blurBackground.isEmpty();
+        if (localBlur)
+            blurBackground = filePath;
+
+        if (WorkspaceBackground *cache = cacheEntry(key, filePath)) {
+            cache->blurBackground = blurBackground;
+            cache->localBlur = localBlur;
+            warmImageCache(key);
+        }
+
+        if (key != m_currentKey)
+            return;
+
+        m_blurBackground = blurBackground;
+        if (localBlur)
+            emit currentWorkspaceLocalBlurBackgroundChanged(m_blurBackground);
+        else
             emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
     });
     QFuture<QString> imageblurFuture = QtConcurrent::run([this, filePath]() ->QString {
         if (m_imageblur.isNull())
-            return filePath;
+            return QString();
 
         QDBusPendingReply<QString> blurReply = m_imageblur->Get(filePath);
         blurReply.waitForFinished();
-        if (m_imageEffectInter.isNull())
-            return filePath;
+        if (blurReply.isError() || m_imageEffectInter.isNull())
+            return QString();
 
         // 处理完会触发BlurDone信号,总之 imageblurFuture 必须得有返回值,否则会导致imageEffectWatcher->result()获取不到值导致异常
         QDBusPendingReply<QString> effectInterReply = m_imageEffectInter->Get("", blurReply.value());
         effectInterReply.waitForFinished();
         if (effectInterReply.isError())
-            return filePath;
+            return QString();
 
         return effectInterReply.value();
     });
@@ -90,11 +172,22 @@ void BackgroundManager::getImageDataFromDbus(const QString &filePath)
 
     // 异步获取全屏桌面背景
     QFutureWatcher<QString> *effectInterWatcher = new QFutureWatcher<QString> (this);
-    connect(effectInterWatcher, &QFutureWatcher<QString>::finished, this, [this, effectInterWatcher](){
+    connect(effectInterWatcher, &QFutureWatcher<QString>::finished, this, [this, effectInterWatcher, filePath, key](){
         effectInterWatcher->deleteLater();
-        m_background = effectInterWatcher->result();
-        if (!m_background.isEmpty())
-            emit currentWorkspaceBackgroundChanged(m_background);
+        const QString background = effectInterWatcher->result();
+        if (background.isEmpty())
+            return;
+
+        if (WorkspaceBackground *cache = cacheEntry(key, filePath)) {
+            cache->background = background;
+            warmImageCache(key);
+        }
+
+        if (key != m_currentKey)
+            return;
+
+        m_background = background;
+        emit currentWorkspaceBackgroundChanged(m_background);
     });
     QFuture<QString> effectInterFuture = QtConcurrent::run([this, filePath]() ->QString {
         if (!m_imageEffectInter)
@@ -111,7 +204,21 @@ void BackgroundManager::getImageDataFromDbus(const QString &filePath)
     effectInterWatcher->setFuture(effectInterFuture);
 }
 
-void BackgroundManager::updateBlurBackgrounds()
+/**
+ * @brief BackgroundManager::effectServiceValid
+ * @return 系统总线上的 ImageBlur 及 ImageEffect 服务是否可用
+ */
+bool BackgroundManager::effectServiceValid() const
+{
+    return !m_imageblur.isNull() && m_imageblur->isValid()
+            && !m_imageEffectInter.isNull() && m_imageEffectInter->isValid();
+}
+
+/**
+ * @brief BackgroundManager::currentScreenName
+ * @return 启动器所在显示器的名称, 复制模式下为主屏
+ */
+QString BackgroundManager::currentScreenName() const
 {
     QString screenName = AppsManager::instance()->currentScreen()->name();
 
@@ -121,27 +228,182 @@ void BackgroundManager::updateBlurBackgrounds()
         int screenIndex = desktopwidget->screenNumber(parentWidget);
         QList<QScreen *> screens = qApp->screens();
 
-        if (screenIndex != -1)
+        if (screenIndex >= 0 && screenIndex < screens.count())
             screenName = screens[screenIndex]->name();
     }
 
+    return screenName;
+}
+
+/**
+ * @brief BackgroundManager::backgroundKey
+ * @param screenName 显示器名称
+ * @param workspace 工作区编号
+ * @return 背景缓存键, 工作区未知时返回空字符串(不缓存)
+ */
+QString BackgroundManager::backgroundKey(const QString &screenName, int workspace)
+{
+    if (workspace < 1)
+        return QString();
+
+    return QString("%1_%2").arg(screenName).arg(workspace);
+}
+
+/**
+ * @brief BackgroundManager::cacheValid
+ * @param key 缓存键
+ * @return 缓存中的背景是否完整且原始壁纸未被修改
+ */
+bool BackgroundManager::cacheValid(const QString &key) const
+{
+    if (key.isEmpty())
+        return false;
+
+    const WorkspaceBackground cache = m_backgroundCache.value(key);
+    if (cache.wallpaper.isEmpty() || cache.background.isEmpty() || cache.blurBackground.isEmpty())
+        return false;
+
+    return QFileInfo(cache.wallpaper).lastModified().toMSecsSinceEpoch() == cache.lastModified;
+}
+
+/**
+ * @brief BackgroundManager::cacheEntry
+ * @param key 缓存键
+ * @param filePath 原始壁纸路径
+ * @return 对应的缓存项, 不存在或壁纸已经变化时返回空指针
+ */
+WorkspaceBackground *BackgroundManager::cacheEntry(const QString &key, const QString &filePath)
+{
+    if (key.isEmpty())
+        return nullptr;
+
+    auto it = m_backgroundCache.find(key);
+    if (it == m_backgroundCache.end() || it->wallpaper != filePath)
+        return nullptr;
+
+    return &it.value();
+}
+
+/**
+ * @brief BackgroundManager::applyCachedBackground 使用缓存的背景, 无需请求 DBus 服务
+ * @param key 缓存键
+ * @return 缓存有效时返回true
+ */
+bool BackgroundManager::applyCachedBackground(const QString &key)
+{
+    if (!cacheValid(key))
+        return false;
+
+    const WorkspaceBackground cache = m_backgroundCache.value(key);
+    m_fileName = cache.wallpaper;
+    m_background = cache.background;
+    m_blurBackground = cache.blurBackground;
+
+    emit currentWorkspaceBackgroundChanged(m_background);
+    if (cache.localBlur)
+        emit currentWorkspaceLocalBlurBackgroundChanged(m_blurBackground);
+    else
+        emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
+
+    return true;
+}
+
+/**
+ * @brief BackgroundManager::removeCache 工作区壁纸变化时移除对应的缓存
+ * @param workspace 工作区编号
+ * @param screenName 显示器名称, 为空时移除所有显示器上该工作区的缓存
+ */
+void BackgroundManager::removeCache(int workspace, const QString &screenName)
+{
+    for (auto it = m_backgroundCache.begin(); it != m_backgroundCache.end();) {
+        if (it->workspace == workspace && (screenName.isEmpty() || it->screenName == screenName)) {
+            m_pendingKeys.remove(it.key());
+            it = m_backgroundCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief BackgroundManager::warmImageCache 预先在工作线程中解码缩放背景图片,
+ * 只处理与当前显示器或当前工作区相邻的背景, 避免超出图片缓存的上限
+ * @param key 缓存键
+ */
+void BackgroundManager::warmImageCache(const QString &key)
+{
+    // 当前背景由 BoxFrame 自行加载
+    if (key == m_currentKey || !cacheValid(key))
+        return;
+
+    const WorkspaceBackground cache = m_backgroundCache.value(key);
+    if (cache.screenName != currentScreenName() && cache.workspace != m_currentWorkspace)
+        return;
+
+    for (QScreen *screen : qApp->screens()) {
+        if (screen->name() != cache.screenName)
+            continue;
+
+        const QSize size = screen->size() * screen->devicePixelRatio();
+        m_bgLoader->loadImage(cache.background, size);
+        m_bgLoader->loadImage(cache.blurBackground, size, cache.localBlur ? BackgroundLoader::Blur : BackgroundLoader::Normal);
+        break;
+    }
+}
+
+/**
+ * @brief BackgroundManager::updateBlurBackgrounds 更新当前显示器及工作区的背景, 优先使用缓存
+ */
+void BackgroundManager::updateBlurBackgrounds()
+{
+    const QString screenName = currentScreenName();
+    m_currentKey = backgroundKey(screenName, m_currentWorkspace);
+
+    // 移动到其他屏幕或切换工作区时直接使用预处理的结果
+    if (applyCachedBackground(m_currentKey))
+        return;
+
+    if (m_pendingKeys.contains(m_currentKey))
+        return;
+
+    m_pendingKeys.insert(m_currentKey);
+    if (!m_currentKey.isEmpty()) {
+        WorkspaceBackground &cache = m_backgroundCache[m_currentKey];
+        cache.screenName = screenName;
+        cache.workspace = m_currentWorkspace;
+    }
+
     QDBusMessage message = QDBusMessage::createMethodCall("org.deepin.dde.Appearance1", "/org/deepin/dde/Appearance1", "org.deepin.dde.Appearance1", "GetCurrentWorkspaceBackgroundForMonitor");
     message << screenName;
 
-    const QDBusPendingReply<QString> result = QDBusConnection::sessionBus().asyncCall(message);
+    const QString key = m_currentKey;
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, key] {
+        watcher->deleteLater();
+        if (!m_pendingKeys.remove(key))
+            return;
+
+        const QDBusPendingReply<QString> reply = *watcher;
+        const QString path = getLocalFile(reply.value());
+        const QString fileName = QFile::exists(path) ? path : DefaultWallpaper;
 
-    QString path = getLocalFile(result.value());
-    m_fileName = QFile::exists(path) ? path : DefaultWallpaper;
+        if (key == m_currentKey)
+            m_fileName = fileName;
 
-    getImageDataFromDbus(m_fileName);
+        getImageDataFromDbus(fileName, key);
+    });
 }
 
 void BackgroundManager::onAppearanceChanged(const QString &type, const QString &str)
 {
     Q_UNUSED(str);
 
-    if (type == "allwallpaperuris")
+    if (type == "allwallpaperuris") {
+        m_backgroundCache.clear();
+        m_pendingKeys.clear();
         updateBlurBackgrounds();
+        schedulePrecompute();
+    }
 }
 
 void BackgroundManager::onDisplayModeChanged(uchar value)
@@ -169,13 +431,26 @@ void BackgroundManager::onGetBlurImageFromDbus(const QString &file, const QStrin
 {
     // 信号返回的文件路径与本地获取的文件路径比对
     if (status && file == m_fileName) {
+        const QString key = m_currentKey;
+
         // 异步获取pixmix处理模糊后的背景(分类模式的视图背景)
         QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-        connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
+        connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher, file, key]{
             imageEffectWatcher->deleteLater();
-            m_blurBackground = imageEffectWatcher->result();
-            if (!m_blurBackground.isEmpty())
-                emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
+            const QString blurBackground = imageEffectWatcher->result();
+            if (blurBackground.isEmpty())
+                return;
+
+            if (WorkspaceBackground *cache = cacheEntry(key, file)) {
+                cache->blurBackground = blurBackground;
+                cache->localBlur = false;
+            }
+
+            if (key != m_currentKey)
+                return;
+
+            m_blurBackground = blurBackground;
+            emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
         });
 
         // 按照dde-session-ui/dde-pixmix 的算法处理
@@ -192,3 +467,103 @@ void BackgroundManager::onGetBlurImageFromDbus(const QString &file, const QStrin
         imageEffectWatcher->setFuture(imageblurFuture);
     }
 }
+
+/**
+ * @brief BackgroundManager::onWorkspaceSwitched 切换工作区
+ * @param from 切换前的工作区
+ * @param to 切换后的工作区
+ */
+void BackgroundManager::onWorkspaceSwitched(int from, int to)
+{
+    Q_UNUSED(from);
+
+    m_currentWorkspace = to;
+    updateBlurBackgrounds();
+
+    // 相邻的背景随当前工作区变化, 重新预先解码
+    for (auto it = m_backgroundCache.constBegin(); it != m_backgroundCache.constEnd(); ++it)
+        warmImageCache(it.key());
+}
+
+void BackgroundManager::onWorkspaceBackgroundChanged(int index, const QString &uri)
+{
+    Q_UNUSED(uri);
+
+    removeCache(index);
+    updateBlurBackgrounds();
+    schedulePrecompute();
+}
+
+void BackgroundManager::onWorkspaceBackgroundChangedForMonitor(int index, const QString &screenName, const QString &uri)
+{
+    Q_UNUSED(uri);
+
+    removeCache(index, screenName);
+    updateBlurBackgrounds();
+    schedulePrecompute();
+}
+
+/**
+ * @brief BackgroundManager::schedulePrecompute 按当前的显示器及工作区数量重新排列待预处理的背景
+ */
+void BackgroundManager::schedulePrecompute()
+{
+    if (m_currentWorkspace < 1)
+        return;
+
+    QDBusPendingCallWatcher *countWatcher = new QDBusPendingCallWatcher(m_wmInter->WorkspaceCount(), this);
+    connect(countWatcher, &QDBusPendingCallWatcher::finished, this, [this, countWatcher] {
+        countWatcher->deleteLater();
+
+        const QDBusPendingReply<int> reply = *countWatcher;
+        if (reply.isError())
+            return;
+
+        m_precomputeQueue.clear();
+        for (QScreen *screen : qApp->screens()) {
+            for (int workspace = 1; workspace <= reply.value(); ++workspace)
+                m_precomputeQueue.append(qMakePair(screen->name(), workspace));
+        }
+
+        m_precomputeTimer->start();
+    });
+}
+
+/**
+ * @brief BackgroundManager::precomputeNext 预处理队列中下一个缓存无效的背景, 完成后等待下一个空闲周期
+ */
+void BackgroundManager::precomputeNext()
+{
+    while (!m_precomputeQueue.isEmpty()) {
+        const QPair<QString, int> item = m_precomputeQueue.takeFirst();
+        const QString key = backgroundKey(item.first, item.second);
+        if (key.isEmpty() || m_pendingKeys.contains(key) || cacheValid(key))
+            continue;
+
+        m_pendingKeys.insert(key);
+
+        WorkspaceBackground &cache = m_backgroundCache[key];
+        cache.screenName = item.first;
+        cache.workspace = item.second;
+
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_wmInter->GetWorkspaceBackgroundForMonitor(item.second, item.first), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, key] {
+            watcher->deleteLater();
+            m_precomputeTimer->start();
+
+            if (!m_pendingKeys.remove(key))
+                return;
+
+            const QDBusPendingReply<QString> reply = *watcher;
+            if (reply.isError()) {
+                qWarning() << "GetWorkspaceBackgroundForMonitor error:" << reply.error();
+                return;
+            }
+
+            const QString path = getLocalFile(reply.value());
+            getImageDataFromDbus(QFile::exists(path) ? path : DefaultWallpaper, key);
+        });
+
+        return;
+    }
+}
@@ -8,6 +8,9 @@
 #include <QObject>
 #include <QDesktopWidget>
 #include <QScreen>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
 #include <DSingleton>
 
 #include "imageeffect_interface.h"
@@ -46,6 +49,23 @@ private:
 };
 
 
+class BackgroundLoader;
+
+/**
+ * @brief The WorkspaceBackground struct
+ * 某个显示器上某个工作区的背景处理结果
+ */
+struct WorkspaceBackground
+{
+    QString screenName;                                     // 显示器名称
+    int workspace = -1;                                     // 工作区编号
+    QString wallpaper;                                      // 原始壁纸路径
+    qint64 lastModified = 0;                                // 原始壁纸修改时间
+    QString background;                                     // 全屏模式背景
+    QString blurBackground;                                 // 分类模式的模糊背景
+    bool localBlur = false;                                 // 模糊背景是否需要本地生成
+};
+
 class BackgroundManager : public QObject
 {
     Q_OBJECT
@@ -55,11 +75,21 @@ public:
     int dispalyMode() const { return m_displayMode; }
 
 private:
-    void getImageDataFromDbus(const QString &filePath);
+    void getImageDataFromDbus(const QString &filePath, const QString &key);
+    bool effectServiceValid() const;
+
+    QString currentScreenName() const;
+    static QString backgroundKey(const QString &screenName, int workspace);
+    bool cacheValid(const QString &key) const;
+    WorkspaceBackground *cacheEntry(const QString &key, const QString &filePath);
+    bool applyCachedBackground(const QString &key);
+    void removeCache(int workspace, const QString &screenName = QString());
+    void warmImageCache(const QString &key);
 
 signals:
     void currentWorkspaceBackgroundChanged(const QString &background);
     void currentWorkspaceBlurBackgroundChanged(const QString &background);
+    void currentWorkspaceLocalBlurBackgroundChanged(const QString &background);
     void blurImageAcquired();
 
 public slots:
@@ -69,8 +99,21 @@ public slots:
     void onPrimaryChanged(const QString & value);
     void onGetBlurImageFromDbus(const QString &file, const QString &blurFile, bool status);
 
+private slots:
+    void onWorkspaceSwitched(int from, int to);
+    void onWorkspaceBackgroundChanged(int index, const QString &uri);
+    void onWorkspaceBackgroundChangedForMonitor(int index, const QString &screenName, const QString &uri);
+    void schedulePrecompute();
+    void precomputeNext();
+
 private:
     int m_currentWorkspace;
+    QString m_currentKey;                                   // 当前显示器及工作区对应的缓存键
+    QHash<QString, WorkspaceBackground> m_backgroundCache;  // 按(显示器, 工作区)缓存的背景
+    QSet<QString> m_pendingKeys;                            // 正在获取壁纸的缓存键
+    QList<QPair<QString, int>> m_precomputeQueue;           // 待预处理的(显示器, 工作区)
+    QTimer *m_precomputeTimer;                              // 空闲时逐个预处理背景
+    BackgroundLoader *m_bgLoader;                           // 预先解码缩放背景图片
     mutable QString m_blurBackground;
     mutable QString m_background;
 
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "blurengine.h"
+
+#include <QtGlobal>
+
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// 模糊前缩小到的最大宽度, 既保证效果也控制耗时
+static const int BLUR_SAMPLE_WIDTH = 480;
+// 缩小后的模糊半径
+static const int BLUR_RADIUS = 8;
+// 三次盒式模糊近似高斯模糊
+static const int BLUR_PASSES = 3;
+// 压暗系数, 与分类模式背景的显示效果保持一致
+static const qreal DARKEN_FACTOR = 0.75;
+
+namespace {
+
+/*
+ * 每个像素的4个通道放在一个向量中计算, 行和列使用同一个累加实现,
+ * 不支持 SIMD 的平台使用普通整型计算
+ */
+#if defined(__SSE2__)
+typedef __m128i PixelSum;
+
+inline PixelSum loadPixel(const quint32 pixel)
+{
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(pixel)), zero), zero);
+}
+
+inline PixelSum zeroSum() { return _mm_setzero_si128(); }
+inline PixelSum addSum(const PixelSum &a, const PixelSum &b) { return _mm_add_epi32(a, b); }
+inline PixelSum subSum(const PixelSum &a, const PixelSum &b) { return _mm_sub_epi32(a, b); }
+
+inline quint32 storePixel(const PixelSum &sum, const float scale)
+{
+    __m128i value = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(scale)));
+    value = _mm_packs_epi32(value, value);
+    value = _mm_packus_epi16(value, value);
+    return quint32(_mm_cvtsi128_si32(value));
+}
+#elif defined(__ARM_NEON)
+typedef int32x4_t PixelSum;
+
+inline PixelSum loadPixel(const quint32 pixel)
+{
+    const uint16x8_t value = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)));
+    return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(value)));
+}
+
+inline PixelSum zeroSum() { return vdupq_n_s32(0); }
+inline PixelSum addSum(const PixelSum &a, const PixelSum &b) { return vaddq_s32(a, b); }
+inline PixelSum subSum(const PixelSum &a, const PixelSum &b) { return vsubq_s32(a, b); }
+
+inline quint32 storePixel(const PixelSum &sum, const float scale)
+{
+    const float32x4_t value = vmlaq_n_f32(vdupq_n_f32(0.5f), vcvtq_f32_s32(sum), scale);
+    const uint16x4_t value16 = vmovn_u32(vcvtq_u32_f32(value));
+    const uint8x8_t value8 = vmovn_u16(vcombine_u16(value16, value16));
+    return vget_lane_u32(vreinterpret_u32_u8(value8), 0);
+}
+#else
+struct PixelSum
+{
+    int channel[4];
+};
+
+inline PixelSum loadPixel(const quint32 pixel)
+{
+    return PixelSum { { int(pixel & 0xff), int((pixel >> 8) & 0xff), int((pixel >> 16) & 0xff), int(pixel >> 24) } };
+}
+
+inline PixelSum zeroSum() { return PixelSum { { 0, 0, 0, 0 } }; }
+
+inline PixelSum addSum(const PixelSum &a, const PixelSum &b)
+{
+    return PixelSum { { a.channel[0] + b.channel[0], a.channel[1] + b.channel[1], a.channel[2] + b.channel[2], a.channel[3] + b.channel[3] } };
+}
+
+inline PixelSum subSum(const PixelSum &a, const PixelSum &b)
+{
+    return PixelSum { { a.channel[0] - b.channel[0], a.channel[1] - b.channel[1], a.channel[2] - b.channel[2], a.channel[3] - b.channel[3] } };
+}
+
+inline quint32 storePixel(const PixelSum &sum, const float scale)
+{
+    quint32 pixel = 0;
+    for (int i = 0; i < 4; ++i)
+        pixel |= quint32(qBound(0, qRound(sum.channel[i] * scale), 255)) << (i * 8);
+
+    return pixel;
+}
+#endif
+
+/**
+ * @brief boxBlurLine 对一行或一列像素做盒式模糊, 边缘像素重复使用
+ * @param src 输入像素
+ * @param dst 输出像素
+ * @param length 像素个数
+ * @param srcStride 输入中相邻像素间隔(以像素为单位)
+ * @param dstStride 输出中相邻像素间隔(以像素为单位)
+ * @param radius 模糊半径
+ */
+void boxBlurLine(const quint32 *src, quint32 *dst, const int length, const int srcStride, const int dstStride, const int radius)
+{
+    const float scale = 1.0f / (radius * 2 + 1);
+    const int last = length - 1;
+
+    PixelSum sum = zeroSum();
+    for (int i = -radius; i <= radius; ++i)
+        sum = addSum(sum, loadPixel(src[qBound(0, i, last) * srcStride]));
+
+    for (int x = 0; x < length; ++x) {
+        dst[x * dstStride] = storePixel(sum, scale);
+
+        sum = addSum(sum, loadPixel(src[qMin(x + radius + 1, last) * srcStride]));
+        sum = subSum(sum, loadPixel(src[qMax(x - radius, 0) * srcStride]));
+    }
+}
+
+}
+
+/**
+ * @brief BlurEngine::effectImage 生成分类模式使用的模糊压暗背景
+ * @param image 原始壁纸(任意大小)
+ * @param size 输出大小
+ * @return 模糊压暗后的背景
+ */
+QImage BlurEngine::effectImage(const QImage &image, const QSize &size)
+{
+    if (image.isNull() || size.isEmpty())
+        return QImage();
+
+    // 在缩小的图片上模糊, 放大后的效果与直接模糊大图一致
+    QImage sample = image;
+    if (sample.width() > BLUR_SAMPLE_WIDTH)
+        sample = sample.scaledToWidth(BLUR_SAMPLE_WIDTH, Qt::SmoothTransformation);
+
+    QImage result = blur(sample, BLUR_RADIUS);
+    darken(result, DARKEN_FACTOR);
+
+    return result.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+}
+
+/**
+ * @brief BlurEngine::blur 可分离的盒式模糊, 先水平后垂直, 重复多次
+ * @param image 输入图片
+ * @param radius 模糊半径
+ * @return 模糊后的图片
+ */
+QImage BlurEngine::blur(const QImage &image, const int radius)
+{
+    QImage result = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (result.isNull() || radius <= 0)
+        return result;
+
+    const int width = result.width();
+    const int height = result.height();
+    const int stride = result.bytesPerLine() / int(sizeof(quint32));
+
+    std::vector<quint32> buffer(size_t(qMax(width, height)));
+    quint32 *bits = reinterpret_cast<quint32 *>(result.bits());
+
+    for (int pass = 0; pass < BLUR_PASSES; ++pass) {
+        for (int y = 0; y < height; ++y) {
+            quint32 *line = bits + y * stride;
+            boxBlurLine(line, buffer.data(), width, 1, 1, radius);
+            std::copy(buffer.begin(), buffer.begin() + width, line);
+        }
+
+        for (int x = 0; x < width; ++x) {
+            quint32 *column = bits + x;
+            // 列像素不连续, 结果先写入连续的缓冲区再写回
+            boxBlurLine(column, buffer.data(), height, stride, 1, radius);
+            for (int y = 0; y < height; ++y)
+                column[y * stride] = buffer[size_t(y)];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief BlurEngine::darken 按比例压暗颜色通道, 透明度不变
+ * @param image 预乘格式的图片
+ * @param factor 压暗系数, 取值 0~1
+ */
+void BlurEngine::darken(QImage &image, const qreal factor)
+{
+    if (image.format() != QImage::Format_ARGB32_Premultiplied)
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    const int scale = qBound(0, qRound(factor * 256), 256);
+    for (int y = 0; y < image.height(); ++y) {
+        quint32 *line = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const quint32 pixel = line[x];
+            const quint32 rb = (((pixel & 0x00ff00ff) * quint32(scale)) >> 8) & 0x00ff00ff;
+            const quint32 g = (((pixel & 0x0000ff00) * quint32(scale)) >> 8) & 0x0000ff00;
+            line[x] = (pixel & 0xff000000) | rb | g;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BLURENGINE_H
+#define BLURENGINE_H
+
+#include <QImage>
+
+/**
+ * @brief The BlurEngine class
+ * 本地模糊及压暗处理, 在缩小后的图片上做多次盒式模糊近似高斯模糊,
+ * 用于系统总线上没有 ImageBlur/ImageEffect 服务或服务处理失败的情况
+ */
+class BlurEngine
+{
+public:
+    static QImage effectImage(const QImage &image, const QSize &size);
+    static QImage blur(const QImage &image, const int radius);
+    static void darken(QImage &image, const qreal factor);
+};
+
+#endif // BLURENGINE_H
@@ -4,6 +4,7 @@
 
 #include "boxframe.h"
 #include "backgroundmanager.h"
+#include "backgroundloader.h"
 #include "util.h"
 #include "constants.h"
 
@@ -21,17 +22,22 @@
  */
 BoxFrame::BoxFrame(QWidget *parent)
     : QLabel(parent)
-    , m_defaultBg("/usr/share/backgrounds/default_background.jpg")
     , m_bgManager(nullptr)
+    , m_bgLoader(nullptr)
     , m_useSolidBackground(false)
+    , m_localBlur(false)
 {
-    m_useSolidBackground = ConfigWorker::getValue(DLauncher::USE_SOLID_BACKGROUND, false).toBool();
+    m_useSolidBackground = ConfigWorker::snapshot()->useSolidBackground;
     if (m_useSolidBackground)
         return;
 
+    m_bgLoader = new BackgroundLoader(this);
+    connect(m_bgLoader, &BackgroundLoader::imageLoaded, this, &BoxFrame::onImageLoaded);
+
     m_bgManager = new BackgroundManager(this);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBackgroundChanged, this, &BoxFrame::setBackground);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBlurBackgroundChanged, this, &BoxFrame::setBlurBackground);
+    connect(m_bgManager, &BackgroundManager::currentWorkspaceLocalBlurBackgroundChanged, this, &BoxFrame::setLocalBlurBackground);
 }
 
 void BoxFrame::setBackground(const QString &url)
@@ -46,10 +52,26 @@ void BoxFrame::setBackground(const QString &url)
 
 void BoxFrame::setBlurBackground(const QString &url)
 {
-    if (m_lastBlurUrl == url)
+    if (m_lastBlurUrl == url && !m_localBlur)
+        return;
+
+    m_lastBlurUrl = url;
+    m_localBlur = false;
+
+    scaledBlurBackground();
+}
+
+/**
+ * @brief BoxFrame::setLocalBlurBackground 模糊服务不可用时, 由本地对壁纸做模糊压暗处理
+ * @param url 原始壁纸路径
+ */
+void BoxFrame::setLocalBlurBackground(const QString &url)
+{
+    if (m_lastBlurUrl == url && m_localBlur)
         return;
 
     m_lastBlurUrl = url;
+    m_localBlur = true;
 
     scaledBlurBackground();
 }
@@ -65,21 +87,18 @@ void BoxFrame::scaledBlurBackground()
     const QSize &size = currentScreen()->size() * currentScreen()->devicePixelRatio();
     static QString blurBgPath;
     static QSize lastSize;
+    static bool lastLocalBlur = false;
 
     // 当背景图片路径且屏幕大小没有变化，则无需再次加载,减少资源加载耗时
-    if (blurBgPath == m_lastBlurUrl && size == lastSize)
+    if (blurBgPath == m_lastBlurUrl && size == lastSize && lastLocalBlur == m_localBlur)
         return;
 
     blurBgPath = m_lastBlurUrl;
     lastSize = size;
+    lastLocalBlur = m_localBlur;
 
-    QPixmap pixmap(m_lastBlurUrl);
-    if (pixmap.isNull())
-        pixmap.load(m_defaultBg);
-
-    QPixmap scaledpixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                                         Qt::SmoothTransformation);
-    emit backgroundImageChanged(scaledpixmap);
+    // 在工作线程中解码缩放, 完成后在 onImageLoaded 中处理
+    m_bgLoader->loadImage(m_lastBlurUrl, size, m_localBlur ? BackgroundLoader::Blur : BackgroundLoader::Normal);
 }
 
 /** 缩放图片并缓存
@@ -101,13 +120,36 @@ void BoxFrame::scaledBackground()
     bgPath = m_lastUrl;
     lastSize = size;
 
-    QPixmap pixmap(m_lastUrl);
-    if (pixmap.isNull())
-        pixmap = QPixmap(m_defaultBg);
+    m_bgLoader->loadImage(m_lastUrl, size);
+}
+
+/**
+ * @brief BoxFrame::onImageLoaded 壁纸解码缩放完成, 仅处理与当前背景及屏幕大小一致的结果
+ * @param path 壁纸路径
+ * @param size 缩放后的大小
+ * @param type 原始壁纸或本地模糊后的壁纸
+ * @param image 缩放后的图片
+ */
+void BoxFrame::onImageLoaded(const QString &path, const QSize &size, const BackgroundLoader::ImageType type, const QImage &image)
+{
+    if (size != currentScreen()->size() * currentScreen()->devicePixelRatio())
+        return;
+
+    if (type == BackgroundLoader::Blur) {
+        if (path == m_lastBlurUrl && m_localBlur)
+            emit backgroundImageChanged(QPixmap::fromImage(image));
+
+        return;
+    }
+
+    // 模糊背景与普通背景可能是同一张图片
+    if (path == m_lastUrl) {
+        m_pixmap = QPixmap::fromImage(image);
+        update();
+    }
 
-    m_pixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                             Qt::SmoothTransformation);
-    update();
+    if (path == m_lastBlurUrl && !m_localBlur)
+        emit backgroundImageChanged(QPixmap::fromImage(image));
 }
 
 const QScreen *BoxFrame::currentScreen()
@@ -8,6 +8,8 @@
 #include <QLabel>
 #include <QPixmapCache>
 
+#include "backgroundloader.h"
+
 class QPixmap;
 class BackgroundManager;
 class QScreen;
@@ -21,6 +23,7 @@ public:
 
     void setBackground(const QString &url);
     void setBlurBackground(const QString &url);
+    void setLocalBlurBackground(const QString &url);
 
 signals:
     void backgroundImageChanged(const QPixmap & img);
@@ -31,6 +34,9 @@ protected:
     void paintEvent(QPaintEvent *event) Q_DECL_OVERRIDE;
     void moveEvent(QMoveEvent *event) Q_DECL_OVERRIDE;
 
+private slots:
+    void onImageLoaded(const QString &path, const QSize &size, const BackgroundLoader::ImageType type, const QImage &image);
+
 private:
     virtual const QScreen * currentScreen();
 
@@ -38,11 +44,12 @@ private:
     QString m_lastUrl;
     QString m_lastBlurUrl;
     QPixmap m_pixmap;
-    QString m_defaultBg;
     QPixmapCache::Key m_cacheNormalKey;
     QPixmapCache::Key m_cacheBlurKey;
     BackgroundManager *m_bgManager;
+    BackgroundLoader *m_bgLoader;                   // 在工作线程中解码缩放壁纸
     bool m_useSolidBackground;
+    bool m_localBlur;                               // 模糊背景是否由本地处理
 };
 
 #endif // BOXFRAME_H
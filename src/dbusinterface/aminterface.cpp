@@ -5,10 +5,10 @@
 #include "aminterface.h"
 #include "appsmanager.h"
 #include "util.h"
+#include "stringpool.h"
 
 #include <mutex>
 
-static const QString KeyAppsDisableScaling = "Apps_Disable_Scaling";
 static const QString AMServiceName = "org.desktopspec.ApplicationManager1";
 static const QString AMServicePath  = "/org/desktopspec/ApplicationManager1";
 static const QString AMInterfaceName  = "org.desktopspec.DBus.ObjectManager";
@@ -123,10 +123,10 @@ bool AMInter::isAMReborn()
 ItemInfoList_v2 AMInter::allInfos()
 {
     ItemInfoList_v2 itemInfoList_v2;
-    const auto itemInfoList_V3 = m_infos.values();
-    for (auto info : itemInfoList_V3) {
-        itemInfoList_v2.append(itemInfoV2(info));
-    }
+    itemInfoList_v2.reserve(m_infos.size());
+    for (auto it = m_infos.cbegin(); it != m_infos.cend(); ++it)
+        itemInfoList_v2.append(itemInfoV2(it.value()));
+
     return itemInfoList_v2;
 }
 
@@ -347,10 +347,7 @@ bool AMInter::disableScaling(const QString &appId)
     if (itemInfo.isInvalid())
         return false;
 
-    if (disableScalingApps().contains(appId))
-        return true;
-
-    return false;
+    return ConfigWorker::snapshot()->disableScalingApps.contains(appId);
 }
 
 QStringList AMInter::autostartList() const
@@ -436,14 +433,14 @@ bool AMInter::lastoreUninstall(const QString &pkgName)
 
 bool AMInter::shouldDisableScaling(const QString &appId)
 {
-    return disableScalingApps().contains(appId);
+    return ConfigWorker::snapshot()->disableScalingApps.contains(appId);
 }
 
 QStringList AMInter::disableScalingApps() const
 {
     QStringList ret;
 
-    QVariant value = ConfigWorker::getValue(KeyAppsDisableScaling, ret);
+    QVariant value = ConfigWorker::getValue(DLauncher::APPS_DISABLE_SCALING, ret);
     auto apps = value.toList();
     for (auto app : apps) {
         ret.append(app.toString());
@@ -458,7 +455,7 @@ void AMInter::setDisableScalingApps(const QStringList &value)
     for (const auto &app : value)
         apps.push_back(app);
 
-    ConfigWorker::setValue(KeyAppsDisableScaling, apps);
+    ConfigWorker::setValue(DLauncher::APPS_DISABLE_SCALING, apps);
 }
 
 void AMInter::monitorAutoStartFiles()
@@ -579,10 +576,12 @@ ItemInfo_v2 AMInter::itemInfoV2(const ItemInfo_v3 &itemInfoV3)
             }
         }
     }
-    info_v2.m_desktop = itemInfoV3.m_id;
+    // desktop 路径和 key 使用同一个驻留的标识
+    const QString appId = StringPool::intern(itemInfoV3.m_id);
+    info_v2.m_desktop = appId;
     info_v2.m_name = zh_displayName.isEmpty() ? defaultDisplayName : zh_displayName;
-    info_v2.m_key = itemInfoV3.m_id;
-    info_v2.m_iconKey = iconName;
+    info_v2.m_key = appId;
+    info_v2.m_iconKey = StringPool::intern(iconName);
     info_v2.m_keywords.append(defaultDisplayName);
     info_v2.m_categoryId = itemInfoV3.category();
 
@@ -4,30 +4,25 @@
 
 #include "iteminfo.h"
 #include "aminterface.h"
+#include "stringpool.h"
 #include <QDebug>
 
-ItemInfo::ItemInfo()
-    : m_openCount(0)
-    , m_firstRunTime(0)
+/**
+ * @brief internIdentifiers 驻留应用的标识字符串, 使各列表中相同的标识共享数据
+ * @param info 应用信息
+ */
+template <typename T>
+static void internIdentifiers(T &info)
 {
+    info.m_desktop = StringPool::intern(info.m_desktop);
+    info.m_key = StringPool::intern(info.m_key);
+    info.m_iconKey = StringPool::intern(info.m_iconKey);
 }
 
-ItemInfo::ItemInfo(const ItemInfo &info)
-    : m_desktop(info.m_desktop)
-    , m_name(info.m_name)
-    , m_key(info.m_key)
-    , m_iconKey(info.m_iconKey)
-    , m_categoryId(info.m_categoryId)
-    , m_installedTime(info.m_installedTime)
-    , m_openCount(info.m_openCount)
-    , m_firstRunTime(info.m_firstRunTime)
-{
-
-}
-
-ItemInfo::~ItemInfo()
+ItemInfo::ItemInfo()
+    : m_openCount(0)
+    , m_firstRunTime(0)
 {
-
 }
 
 void ItemInfo::registerMetaType()
@@ -61,9 +56,10 @@ AppsListModel::AppCategory ItemInfo::category() const
 
 bool ItemInfo::operator==(const ItemInfo &other) const
 {
-    return (m_desktop == other.m_desktop && m_name == other.m_name &&
-            m_key == other.m_key && m_iconKey == other.m_iconKey &&
-            m_categoryId == other.m_categoryId && m_openCount == other.m_openCount);
+    // 先比较整型字段, 再比较字符串
+    return (m_categoryId == other.m_categoryId && m_openCount == other.m_openCount &&
+            m_desktop == other.m_desktop && m_key == other.m_key &&
+            m_iconKey == other.m_iconKey && m_name == other.m_name);
 }
 
 void ItemInfo::updateInfo(const ItemInfo &info)
@@ -108,6 +104,8 @@ const QDataStream &operator>>(QDataStream &argument, ItemInfo &info)
     argument >> info.m_desktop >> info.m_name >> info.m_key >> info.m_iconKey;
     argument >> info.m_categoryId >> info.m_installedTime >> info.m_firstRunTime;
 
+    internIdentifiers(info);
+
     return argument;
 }
 
@@ -118,6 +116,8 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, ItemInfo &info)
     argument >> info.m_categoryId >> info.m_installedTime;
     argument.endStructure();
 
+    internIdentifiers(info);
+
     return argument;
 }
 
@@ -138,24 +138,8 @@ ItemInfo_v1::ItemInfo_v1()
 {
 }
 
-ItemInfo_v1::ItemInfo_v1(const ItemInfo_v1 &info)
-    : m_desktop(info.m_desktop)
-    , m_name(info.m_name)
-    , m_key(info.m_key)
-    , m_iconKey(info.m_iconKey)
-    , m_status(info.m_status)
-    , m_categoryId(info.m_categoryId)
-    , m_description(info.m_description)
-    , m_progressValue(info.m_progressValue)
-    , m_installedTime(info.m_installedTime)
-    , m_openCount(info.m_openCount)
-    , m_firstRunTime(info.m_firstRunTime)
-    , m_isDir(info.m_isDir)
-    , m_appInfoList(info.m_appInfoList)
-{
-}
-
 ItemInfo_v1::ItemInfo_v1(const AppInfo &info)
+    : ItemInfo_v1()
 {
     m_desktop = info.m_desktop;
     m_name = info.m_name;
@@ -165,6 +149,8 @@ ItemInfo_v1::ItemInfo_v1(const AppInfo &info)
     m_categoryId = info.m_categoryId;
     m_description = info.m_description;
     m_progressValue = info.m_progressValue;
+
+    internIdentifiers(*this);
 }
 
 ItemInfo_v1::ItemInfo_v1(const ItemInfo &info)
@@ -202,12 +188,33 @@ ItemInfo_v1::ItemInfo_v1(const ItemInfo_v2 &info)
 {
 }
 
+/**
+ * @brief ItemInfo_v1::ItemInfo_v1 从 DBus 返回的数据中转移字符串, 避免再次复制
+ * @param info AM 提供的应用信息
+ */
+ItemInfo_v1::ItemInfo_v1(ItemInfo_v2 &&info)
+    : m_desktop(std::move(info.m_desktop))
+    , m_name(std::move(info.m_name))
+    , m_key(std::move(info.m_key))
+    , m_iconKey(std::move(info.m_iconKey))
+    , m_keywords(std::move(info.m_keywords))
+    , m_status(0)
+    , m_categoryId(info.m_categoryId)
+    , m_progressValue(0)
+    , m_installedTime(info.m_installedTime)
+    , m_openCount(0)
+    , m_firstRunTime(0)
+    , m_isDir(false)
+{
+}
+
 ItemInfoList_v1 ItemInfo_v1::appListToItemV1List(const AppInfoList &list)
 {
     ItemInfoList_v1 itemInfoList;
+    itemInfoList.reserve(list.size());
 
-    foreach (const ItemInfo_v1 &itemInfo, list)
-        itemInfoList << itemInfo;
+    for (const AppInfo &info : list)
+        itemInfoList.append(ItemInfo_v1(info));
 
     return itemInfoList;
 }
@@ -215,9 +222,10 @@ ItemInfoList_v1 ItemInfo_v1::appListToItemV1List(const AppInfoList &list)
 ItemInfoList_v1 ItemInfo_v1::itemListToItemV1List(const ItemInfoList &list)
 {
     ItemInfoList_v1 itemInfoList;
+    itemInfoList.reserve(list.size());
 
-    foreach (const ItemInfo &info, list)
-        itemInfoList << info;
+    for (const ItemInfo &info : list)
+        itemInfoList.append(ItemInfo_v1(info));
 
     return itemInfoList;
 }
@@ -225,9 +233,21 @@ ItemInfoList_v1 ItemInfo_v1::itemListToItemV1List(const ItemInfoList &list)
 ItemInfoList_v1 ItemInfo_v1::itemV2ListToItemV1List(const ItemInfoList_v2 &list)
 {
     ItemInfoList_v1 itemInfoList;
+    itemInfoList.reserve(list.size());
 
     for (const ItemInfo_v2 &info : list)
-        itemInfoList << info;
+        itemInfoList.append(ItemInfo_v1(info));
+
+    return itemInfoList;
+}
+
+ItemInfoList_v1 ItemInfo_v1::itemV2ListToItemV1List(ItemInfoList_v2 &&list)
+{
+    ItemInfoList_v1 itemInfoList;
+    itemInfoList.reserve(list.size());
+
+    for (ItemInfo_v2 &info : list)
+        itemInfoList.append(ItemInfo_v1(std::move(info)));
 
     return itemInfoList;
 }
@@ -271,14 +291,9 @@ bool ItemInfo_v1::isLingLongApp() const
 
 bool ItemInfo_v1::isSimilar(const ItemInfo_v1 &other) const
 {
-    return (m_desktop == other.m_desktop && m_key == other.m_key &&
-            m_iconKey == other.m_iconKey && m_categoryId == other.m_categoryId &&
-            m_isDir == other.m_isDir && m_appInfoList == other.m_appInfoList);
-}
-
-ItemInfo_v1::~ItemInfo_v1()
-{
-
+    return (m_categoryId == other.m_categoryId && m_isDir == other.m_isDir &&
+            m_desktop == other.m_desktop && m_key == other.m_key &&
+            m_iconKey == other.m_iconKey && m_appInfoList == other.m_appInfoList);
 }
 
 void ItemInfo_v1::registerMetaType()
@@ -312,11 +327,13 @@ AppsListModel::AppCategory ItemInfo_v1::category() const
 
 bool ItemInfo_v1::operator==(const ItemInfo_v1 &other) const
 {
-    return (m_desktop == other.m_desktop && m_name == other.m_name &&
-            m_key == other.m_key && m_iconKey == other.m_iconKey &&
-            m_keywords == other.m_keywords && m_openCount == other.m_openCount &&
-            m_categoryId == other.m_categoryId && m_description == other.m_description &&
-            m_isDir == other.m_isDir && m_appInfoList == other.m_appInfoList);
+    // 先比较整型字段, 再比较字符串, 最后比较文件夹内容
+    return (m_categoryId == other.m_categoryId && m_openCount == other.m_openCount &&
+            m_isDir == other.m_isDir &&
+            m_desktop == other.m_desktop && m_key == other.m_key &&
+            m_iconKey == other.m_iconKey && m_name == other.m_name &&
+            m_keywords == other.m_keywords && m_description == other.m_description &&
+            m_appInfoList == other.m_appInfoList);
 }
 
 QDebug operator<<(QDebug argument, const ItemInfo_v1 &info)
@@ -346,6 +363,8 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, ItemInfo_v1 &info
     argument >> info.m_categoryId >> info.m_installedTime;
     argument.endStructure();
 
+    internIdentifiers(info);
+
     return argument;
 }
 
@@ -367,6 +386,8 @@ const QDataStream &operator>>(QDataStream &argument, ItemInfo_v1 &info)
     argument >> info.m_progressValue >> info.m_openCount;
     argument >> info.m_isDir >> info.m_appInfoList;
 
+    internIdentifiers(info);
+
     return argument;
 }
 
@@ -397,23 +418,6 @@ ItemInfo_v2::ItemInfo_v2()
 
 }
 
-ItemInfo_v2::ItemInfo_v2(const ItemInfo_v2 &info)
-    : m_desktop(info.m_desktop)
-    , m_name(info.m_name)
-    , m_key(info.m_key)
-    , m_iconKey(info.m_iconKey)
-    , m_categoryId(info.m_categoryId)
-    , m_installedTime(info.m_installedTime)
-    , m_keywords(info.m_keywords)
-{
-
-}
-
-ItemInfo_v2::~ItemInfo_v2()
-{
-
-}
-
 void ItemInfo_v2::registerMetaType()
 {
     qRegisterMetaType<ItemInfo_v2>("ItemInfo_v2");
@@ -444,9 +448,10 @@ AppsListModel::AppCategory ItemInfo_v2::category() const
 
 bool ItemInfo_v2::operator==(const ItemInfo_v2 &other) const
 {
-    return (m_desktop == other.m_desktop && m_name == other.m_name &&
-            m_key == other.m_key && m_iconKey == other.m_iconKey &&
-            m_categoryId == other.m_categoryId && m_keywords == other.m_keywords);
+    return (m_categoryId == other.m_categoryId &&
+            m_desktop == other.m_desktop && m_key == other.m_key &&
+            m_iconKey == other.m_iconKey && m_name == other.m_name &&
+            m_keywords == other.m_keywords);
 }
 
 QDebug operator<<(QDebug argument, const ItemInfo_v2 &info)
@@ -484,6 +489,8 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, ItemInfo_v2 &info
              >> info.m_categoryId >> info.m_installedTime >> info.m_keywords;
     argument.endStructure();
 
+    internIdentifiers(info);
+
     return argument;
 }
 
@@ -492,6 +499,8 @@ const QDataStream &operator>>(QDataStream &argument, ItemInfo_v2 &info)
     argument >> info.m_desktop >> info.m_name >> info.m_key >> info.m_iconKey;
     argument >> info.m_categoryId >> info.m_installedTime >> info.m_keywords;
 
+    internIdentifiers(info);
+
     return argument;
 }
 
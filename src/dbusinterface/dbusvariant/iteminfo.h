@@ -12,14 +12,16 @@
 #include <QDebug>
 #include <QDataStream>
 #include <QtDBus>
+#include <QVector>
 
 class ItemInfo;
 class ItemInfo_v1;
 class ItemInfo_v2;
 
-typedef QList<ItemInfo> ItemInfoList;
-typedef QList<ItemInfo_v1> ItemInfoList_v1;
-typedef QList<ItemInfo_v2> ItemInfoList_v2;
+// 应用信息列表使用连续存储, 避免 QList 为每个元素单独分配内存
+typedef QVector<ItemInfo> ItemInfoList;
+typedef QVector<ItemInfo_v1> ItemInfoList_v1;
+typedef QVector<ItemInfo_v2> ItemInfoList_v2;
 
 /** 1050 版本及之前的原始数据结构,为提升兼容性,
  *  数据接口在下面进行扩展
@@ -29,8 +31,12 @@ class ItemInfo
 {
 public:
     ItemInfo();
-    ItemInfo(const ItemInfo &info);
-    ~ItemInfo();
+    ItemInfo(const ItemInfo &info) = default;
+    ItemInfo(ItemInfo &&info) = default;
+    ~ItemInfo() = default;
+
+    ItemInfo &operator=(const ItemInfo &info) = default;
+    ItemInfo &operator=(ItemInfo &&info) = default;
 
     static void registerMetaType();
 
@@ -70,14 +76,20 @@ public:
     };
 
     explicit ItemInfo_v1();
-    ItemInfo_v1(const ItemInfo_v1 &info);
+    ItemInfo_v1(const ItemInfo_v1 &info) = default;
+    ItemInfo_v1(ItemInfo_v1 &&info) = default;
     ItemInfo_v1(const AppInfo &info);
     ItemInfo_v1(const ItemInfo &info);
     ItemInfo_v1(const ItemInfo_v2 &info);
+    ItemInfo_v1(ItemInfo_v2 &&info);
+
+    ItemInfo_v1 &operator=(const ItemInfo_v1 &info) = default;
+    ItemInfo_v1 &operator=(ItemInfo_v1 &&info) = default;
 
     static ItemInfoList_v1 appListToItemV1List(const AppInfoList &list);
     static ItemInfoList_v1 itemListToItemV1List(const ItemInfoList &list);
     static ItemInfoList_v1 itemV2ListToItemV1List(const ItemInfoList_v2 &list);
+    static ItemInfoList_v1 itemV2ListToItemV1List(ItemInfoList_v2 &&list);
 
     bool isTitle() const;
     bool startWithLetter() const;
@@ -85,7 +97,7 @@ public:
     bool isLingLongApp() const;
     bool isSimilar(const ItemInfo_v1 &other) const;
 
-    ~ItemInfo_v1();
+    ~ItemInfo_v1() = default;
 
     static void registerMetaType();
 
@@ -128,8 +140,12 @@ class ItemInfo_v2
 {
 public:
     ItemInfo_v2();
-    ItemInfo_v2(const ItemInfo_v2 &info);
-    ~ItemInfo_v2();
+    ItemInfo_v2(const ItemInfo_v2 &info) = default;
+    ItemInfo_v2(ItemInfo_v2 &&info) = default;
+    ~ItemInfo_v2() = default;
+
+    ItemInfo_v2 &operator=(const ItemInfo_v2 &info) = default;
+    ItemInfo_v2 &operator=(ItemInfo_v2 &&info) = default;
 
     static void registerMetaType();
 
@@ -7,6 +7,7 @@
 #include "calculate_util.h"
 #include "util.h"
 #include "appslistmodel.h"
+#include "appsmanager.h"
 
 #include <QDebug>
 #include <QPixmap>
@@ -19,6 +20,50 @@
 #define TEXTTOLEFT  10
 #define RECT_REDIUS 18
 
+// 布局缓存上限, 超出后整体清空, 避免窗口反复缩放时无限增长
+static const int MAX_LAYOUT_CACHE_SIZE = 512;
+// 应用项绘制缓存上限(字节)
+static const int MAX_TILE_CACHE_COST = 48 * 1024 * 1024;
+
+// 应用文件夹缩略图中最多显示的应用数
+static const int DIR_THUMBNAIL_ICON_COUNT = 4;
+// 应用文件夹缩略图缓存上限(字节)
+static const int MAX_DIR_THUMBNAIL_CACHE_COST = 16 * 1024 * 1024;
+
+/**
+ * @brief The DirThumbnailKey struct
+ * 应用文件夹缩略图缓存的键, 包含文件夹及其显示的应用, 文件夹内容变化后自然失效
+ */
+struct DirThumbnailKey
+{
+    QString desktop;            // 文件夹 desktop 路径
+    QStringList desktops;       // 缩略图中显示的应用
+    QStringList iconKeys;       // 缩略图中显示的应用图标
+    QSize size;                 // 缩略图大小
+    qreal ratio;                // 设备缩放比
+
+    bool operator==(const DirThumbnailKey &other) const
+    {
+        return desktop == other.desktop && desktops == other.desktops && iconKeys == other.iconKeys
+                && size == other.size && qFuzzyCompare(ratio, other.ratio);
+    }
+};
+
+static uint qHash(const DirThumbnailKey &key, uint seed = 0)
+{
+    return qHash(key.desktop, seed) ^ qHash(key.desktops, seed) ^ qHash(key.iconKeys, seed + 1)
+            ^ qHash(qMakePair(key.size.width(), key.size.height()), seed);
+}
+
+/**
+ * @brief dirThumbnailCache 所有视图共用的应用文件夹缩略图缓存
+ */
+static QCache<DirThumbnailKey, QPixmap> &dirThumbnailCache()
+{
+    static QCache<DirThumbnailKey, QPixmap> cache(MAX_DIR_THUMBNAIL_CACHE_COST);
+    return cache;
+}
+
 QModelIndex AppItemDelegate::CurrentIndex = QModelIndex();
 
 AppItemDelegate::AppItemDelegate(QObject *parent)
@@ -27,6 +72,58 @@ AppItemDelegate::AppItemDelegate(QObject *parent)
     , m_blueDotPixmap(QIcon(":/skin/images/new_install_indicator.svg").pixmap(QSize(10, 10)))
     , m_autoStartPixmap(QIcon(":/skin/images/emblem-autostart.svg").pixmap(QSize(24, 24)))
 {
+    m_tileCache.setMaxCost(MAX_TILE_CACHE_COST);
+
+    // 字体、主题及布局变化后, 已缓存的应用项布局及绘制结果失效
+    connect(qApp, &QGuiApplication::fontChanged, this, &AppItemDelegate::clearCache);
+    connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &AppItemDelegate::clearCache);
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppItemDelegate::clearCache);
+
+    // 单个应用信息变化时只清除该应用的缓存, 列表重置或增删移动时全部清除
+    connect(AppsManager::instance(), &AppsManager::itemDataChanged, this, &AppItemDelegate::removeItemCache);
+    connect(AppsManager::instance(), &AppsManager::dataChanged, this, [ this ] {
+        m_tileCache.clear();
+    });
+    connect(AppsManager::instance(), &AppsManager::itemsChanged, this, [ this ](AppsListModel::AppCategory category, const AppsChange &change) {
+        if (change.type != AppsChange::Update) {
+            m_tileCache.clear();
+            return;
+        }
+
+        for (int row = change.first; row <= change.last; row++)
+            removeItemCache(AppsManager::instance()->appsInfoListIndex(category, row));
+    });
+
+    // 图标主题或图标目录变化后, 所有应用图标及文件夹缩略图需要重新生成
+    connect(AppsManager::instance(), &AppsManager::iconsChanged, this, [ this ] {
+        m_tileCache.clear();
+        dirThumbnailCache().clear();
+    });
+}
+
+void AppItemDelegate::clearCache()
+{
+    m_layoutCache.clear();
+    m_tileCache.clear();
+}
+
+/**
+ * @brief AppItemDelegate::removeItemCache 清除指定应用已缓存的绘制结果
+ * @param info 应用信息
+ */
+void AppItemDelegate::removeItemCache(const ItemInfo_v1 &info)
+{
+    // 文件夹的绘制结果包含缩略图, 其中应用变化后一并清除
+    for (const ItemTileKey &key : m_tileCache.keys()) {
+        if (key.desktop == info.m_desktop || key.dirDesktops.contains(info.m_desktop))
+            m_tileCache.remove(key);
+    }
+
+    // 文件夹中应用的图标变化后, 重新合成包含该应用的缩略图
+    for (const DirThumbnailKey &key : dirThumbnailCache().keys()) {
+        if (key.desktops.contains(info.m_desktop))
+            dirThumbnailCache().remove(key);
+    }
 }
 
 void AppItemDelegate::setCurrentIndex(const QModelIndex &index)
@@ -54,7 +151,9 @@ void AppItemDelegate::setItemList(const ItemInfoList_v1 &items)
 
 void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    if (index.data(AppsListModel::AppItemIsDraggingRole).value<bool>() && !(option.features & QStyleOptionViewItem::HasDisplay))
+    // 一次获取绘制所需的数据, 避免多次查找同一个应用
+    const AppTileInfo tileInfo = index.data(AppsListModel::AppTileInfoRole).value<AppTileInfo>();
+    if (tileInfo.isDragging && !(option.features & QStyleOptionViewItem::HasDisplay))
         return;
 
 #ifdef QT_DEBUG
@@ -66,19 +165,14 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     painter->setPen(Qt::white);
     painter->setBrush(QBrush(Qt::transparent));
 
-    const ItemInfo_v1 itemInfo = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
-    const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
-    const bool itemIsDir = index.data(AppsListModel::ItemIsDirRole).toBool();
-    const ItemInfoList_v1 itemList = index.data(AppsListModel::DirItemInfoRole).value<ItemInfoList_v1>();
-    const int itemStatus = index.data(AppsListModel::AppItemStatusRole).toInt();
-
-    QList<QPixmap> pixmapList;
+    const ItemInfo_v1 &itemInfo = tileInfo.info;
+    const bool itemIsDir = tileInfo.isDir;
+    const int itemStatus = itemInfo.m_status;
 
-    const int fontPixelSize = index.data(AppsListModel::AppFontSizeRole).value<int>();
-    const bool drawBlueDot = index.data(AppsListModel::AppNewInstallRole).toBool();
+    const int fontPixelSize = tileInfo.fontPixelSize;
+    const bool drawBlueDot = tileInfo.newInstall;
     const bool is_current = CurrentIndex == index;
-    const QRect itemBoundRect = itemBoundingRect(option.rect);
-    const QSize iconSize = index.data(AppsListModel::AppIconSizeRole).toSize();
+    const QSize iconSize = tileInfo.iconSize;
 
     QFont appNamefont(painter->font());
     if (fontPixelSize <= 0)
@@ -87,55 +181,25 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     appNamefont.setPixelSize(fontPixelSize);
     const QFontMetrics fm(appNamefont);
     painter->setOpacity(1);
-    const static double x1 = 0.26418192;
-    const static double x2 = -0.38890932;
-    const double result = x1 * itemBoundRect.width() + x2 * iconSize.width();
-    int margin = result > 0 ? result * 0.71 : 1;
 
-    // adjust
-    QRect br;
-    QRect iconRect;
-    QRectF appNameRect;
-    QString appNameResolved;
-    bool adjust = false;
-    bool  TextSecond = 0;
-    do {
-        // adjust
-        if (adjust)
-            --margin;
-        br = itemBoundRect.marginsRemoved(QMargins(margin, 1, margin, margin * 2));
+    const QString &displayName = tileInfo.displayName;
 
-        // calc icon rect
-        const int iconLeftMargins = (br.width() - iconSize.width()) / 2;
-        int iconTopMargin = ICONTOTOP;
-        iconRect = QRect(br.topLeft() + QPoint(iconLeftMargins, iconTopMargin - 2), iconSize);
-
-        //31是字体设置20的时候的高度
-        br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
-        if (br.height() > itemBoundRect.height())
-            br.setHeight(itemBoundRect.height() - 1);
-
-        // calc text
-        appNameRect = itemTextRect(br, iconRect, drawBlueDot);
-
-        bool showSuffix = ConfigWorker::getValue(DLauncher::SHOW_LINGLONG_SUFFIX).toBool();
-        bool isLingLongApp = itemInfo.isLingLongApp();
-        bool isDir = itemInfo.m_isDir;
-        const QString &displayName = (showSuffix && isLingLongApp && !isDir) ? (QString("%1(%2)").arg(itemInfo.m_name).arg(tr("LingLong"))) : itemInfo.m_name;
-        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, displayName, appNameRect.toRect());
-        appNameResolved = appTextResolvedInfo.first;
+    // 布局只与项大小、图标大小、字体、名称及小蓝点有关, 计算结果按项左上角平移后复用
+    const ItemLayoutKey layoutKey { displayName, option.rect.size(), iconSize, appNamefont.key(), drawBlueDot };
+    auto layoutIt = m_layoutCache.constFind(layoutKey);
+    if (layoutIt == m_layoutCache.constEnd()) {
+        if (m_layoutCache.size() >= MAX_LAYOUT_CACHE_SIZE)
+            m_layoutCache.clear();
 
-        if ((fm.width(appNameResolved) + (drawBlueDot ? (m_blueDotPixmap.width() + 10) : 0)) >= appNameRect.width())
-            TextSecond = 1;
-
-        if (margin == 1 || appTextResolvedInfo.second) {
-            br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
-            appNameRect = itemTextRect(br, iconRect, drawBlueDot);
-            break;
-        }
+        layoutIt = m_layoutCache.insert(layoutKey, calcItemLayout(option.rect.size(), iconSize, fm, fontPixelSize, displayName, drawBlueDot));
+    }
 
-        adjust = true;
-    } while (true);
+    const ItemLayout &layout = layoutIt.value();
+    const QPoint offset = option.rect.topLeft();
+    QRect br = layout.boundingRect.translated(offset);
+    const QRect iconRect = layout.iconRect.translated(offset);
+    const QRectF appNameRect = layout.textRect.translated(offset);
+    const QString &appNameResolved = layout.text;
 
     // 绘制选中样式
    if (is_current && !(option.features & QStyleOptionViewItem::HasDisplay) && !itemIsDir && m_calcUtil->fullscreen()) {
@@ -148,7 +212,7 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         if (drawBlueDot)
             drawBlueDotWidth = m_blueDotPixmap.width();
 
-        if (iconSize.width() > (fm.width(appNameResolved) + drawBlueDotWidth)) {
+        if (iconSize.width() > (layout.textWidth + drawBlueDotWidth)) {
             br.setX(iconRect.x() - ICONTOLETF);
             br.setWidth(iconSize.width() + ICONTOLETF * 2);
         }
@@ -167,20 +231,96 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
        painter->drawRoundedRect(br, RECT_REDIUS / 2, RECT_REDIUS / 2);
     }
 
+    const bool autoStart = tileInfo.autoStart;
+
+    // 安装中的应用需要实时绘制进度, 不使用缓存
+    if (m_calcUtil->fullscreen() && !itemIsDir && itemStatus == ItemInfo_v1::Busy) {
+        drawItemContent(painter, index, tileInfo, layout, offset, appNamefont);
+
+        QRectF progressRect, buttonRect;
+        progressRect.setTop(appNameRect.bottom() + 5);
+        progressRect.setLeft(option.rect.left() + (option.rect.right() - option.rect.width() / 3) / 2);
+        progressRect.setWidth(option.rect.width() / 3);
+        progressRect.setHeight(option.rect.height() * 0.05);
+
+        buttonRect.setTop(progressRect.bottom() + 5);
+        buttonRect.setLeft(option.rect.left() + (option.rect.right() - option.rect.width() / 2) / 2);
+        buttonRect.setWidth(option.rect.width() / 2);
+        buttonRect.setHeight(option.rect.height() * 0.15);
+
+        QStyleOptionProgressBar progressBar;
+        progressBar.text = QString::number(itemInfo.m_progressValue);
+        progressBar.minimum = 0;
+        progressBar.maximum = 100;
+        progressBar.progress = itemInfo.m_progressValue;
+        progressBar.invertedAppearance = true;
+        progressBar.orientation = Qt::Horizontal;
+        progressBar.textVisible = true;
+        progressBar.textAlignment = Qt::AlignHCenter;
+        progressBar.rect = progressRect.toRect();
+
+        QStyleOptionButton button;
+        button.rect = buttonRect.toRect();
+        button.text = itemInfo.m_description;
+        QApplication::style()->drawControl(QStyle::CE_ProgressBar, &progressBar, painter);
+        QApplication::style()->drawControl(QStyle::CE_PushButton, &button, painter);
+        return;
+    }
+
+    // 图标、名称及角标绘制到缓存图片中, 选中状态变化时只需重新贴图
+    const qreal ratio = painter->device()->devicePixelRatioF();
+    QStringList dirDesktops;
+    if (itemIsDir) {
+        for (int i = 0; i < qMin(DIR_THUMBNAIL_ICON_COUNT, itemInfo.m_appInfoList.size()); i++)
+            dirDesktops << itemInfo.m_appInfoList.at(i).m_desktop;
+    }
+
+    const ItemTileKey tileKey { layoutKey, itemInfo.m_desktop, itemInfo.m_iconKey, dirDesktops, autoStart, m_calcUtil->fullscreen(), ratio };
+    const QPixmap *cachedTile = m_tileCache.object(tileKey);
+    if (cachedTile) {
+        painter->drawPixmap(option.rect.topLeft(), *cachedTile);
+        return;
+    }
+
+    QPixmap tile(option.rect.size() * ratio);
+    tile.setDevicePixelRatio(ratio);
+    tile.fill(Qt::transparent);
+
+    QPainter tilePainter(&tile);
+    tilePainter.setRenderHints(painter->renderHints());
+    drawItemContent(&tilePainter, index, tileInfo, layout, QPoint(0, 0), appNamefont);
+    tilePainter.end();
+
+    painter->drawPixmap(option.rect.topLeft(), tile);
+    m_tileCache.insert(tileKey, new QPixmap(tile), tile.width() * tile.height() * tile.depth() / 8);
+}
+
+/**
+ * @brief AppItemDelegate::drawItemContent 绘制应用项中不随选中状态变化的部分: 应用文件夹、名称、图标及角标
+ * @param painter 绘画师
+ * @param index 应用模型索引, 用于获取图标, 只在缓存未命中时获取
+ * @param tileInfo 应用项数据, 包含是否绘制新安装应用的小蓝点及自启动角标
+ * @param layout 应用项布局
+ * @param offset 应用项左上角位置
+ * @param appNamefont 应用名称字体
+ */
+void AppItemDelegate::drawItemContent(QPainter *painter, const QModelIndex &index, const AppTileInfo &tileInfo, const ItemLayout &layout,
+                                      const QPoint &offset, const QFont &appNamefont) const
+{
+    const bool itemIsDir = tileInfo.isDir;
+    const bool drawBlueDot = tileInfo.newInstall;
+    const bool autoStart = tileInfo.autoStart;
+    const QRect iconRect = layout.iconRect.translated(offset);
+    const QRectF appNameRect = layout.textRect.translated(offset);
+    const QFontMetrics fm(appNamefont);
+
     // 绘制应用名称
     QTextOption appNameOption;
     appNameOption.setAlignment(Qt::AlignHCenter | Qt::AlignTop);
     appNameOption.setWrapMode(QTextOption::WordWrap);
 
-    appNameRect.setY(br.y() + br.height() - TEXTTOLEFT + (fm.height() >= 28 ? 2 : 0) - fm.height() - fontPixelSize * TextSecond);
-
-    if (drawBlueDot) {
-        appNameRect.setX(appNameRect.x() + m_blueDotPixmap.width() / 2 + 5);
-        appNameRect.setWidth(appNameRect.width() - m_blueDotPixmap.width());
-    }
-
     if (m_calcUtil->fullscreen())
-        drawAppDrawer(painter, index, iconRect);
+        drawAppDrawer(painter, index, tileInfo, iconRect);
 
     painter->setFont(appNamefont);
     painter->setBrush(QBrush(Qt::transparent));
@@ -193,46 +333,14 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
             painter->setPen(Qt::black);
 
         painter->setFont(QFont(painter->font().family(), DLauncher::DEFAULT_FONT_SIZE));
-        painter->drawText(appNameRect, appNameResolved, appNameOption);
-    } else {
-        QRectF progressRect, buttonRect;
-        progressRect.setTop(appNameRect.bottom() + 5);
-        progressRect.setLeft(option.rect.left() + (option.rect.right() - option.rect.width() / 3) / 2);
-        progressRect.setWidth(option.rect.width() / 3);
-        progressRect.setHeight(option.rect.height() * 0.05);
-
-        buttonRect.setTop(progressRect.bottom() + 5);
-        buttonRect.setLeft(option.rect.left() + (option.rect.right() - option.rect.width() / 2) / 2);
-        buttonRect.setWidth(option.rect.width() / 2);
-        buttonRect.setHeight(option.rect.height() * 0.15);
-
-        if (!itemIsDir && itemStatus == ItemInfo_v1::Busy) {
-            painter->drawText(appNameRect, appNameResolved, appNameOption);
-            QStyleOptionProgressBar progressBar;
-            progressBar.text = QString::number(itemInfo.m_progressValue);
-            progressBar.minimum = 0;
-            progressBar.maximum = 100;
-            progressBar.progress = itemInfo.m_progressValue;
-            progressBar.invertedAppearance = true;
-            progressBar.orientation = Qt::Horizontal;
-            progressBar.textVisible = true;
-            progressBar.textAlignment = Qt::AlignHCenter;
-            progressBar.rect = progressRect.toRect();
-
-            QStyleOptionButton button;
-            button.rect = buttonRect.toRect();
-            button.text = itemInfo.m_description;
-            QApplication::style()->drawControl(QStyle::CE_ProgressBar, &progressBar, painter);
-            QApplication::style()->drawControl(QStyle::CE_PushButton, &button, painter);
-        } else {
-            const ItemInfo_v1 info = index.data(AppsListModel::DirNameRole).value<ItemInfo_v1>();
-            painter->drawText(appNameRect, appNameResolved, appNameOption);
-        }
     }
 
+    painter->drawText(appNameRect, layout.text, appNameOption);
+
     if (!itemIsDir) {
+        const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
         painter->drawPixmap(iconRect, iconPix, iconPix.rect());
-        if (index.data(AppsListModel::AppAutoStartRole).toBool()) {
+        if (autoStart) {
             const QPoint autoStartIconPos = iconRect.bottomLeft()
                     - QPoint(m_autoStartPixmap.height(), m_autoStartPixmap.width()) / m_autoStartPixmap.devicePixelRatioF() / 2
                     + QPoint(iconRect.width() / 10, -iconRect.height() / 10);
@@ -242,7 +350,7 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
 
     if (drawBlueDot) {
         const int marginRight = 2;
-        const QRectF textRect = fm.boundingRect(appNameRect.toRect(), Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap, appNameResolved);
+        const QRectF textRect = layout.blueDotTextRect.translated(offset);
         const auto ratio = m_blueDotPixmap.devicePixelRatioF();
         const QPointF blueDotPos = textRect.topLeft() + QPoint(-m_blueDotPixmap.width() / ratio - marginRight,
                                                                (fm.height() - m_blueDotPixmap.height() / ratio) / 2);
@@ -250,6 +358,86 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     }
 }
 
+/**
+ * @brief AppItemDelegate::calcItemLayout 计算应用项的图标、名称区域及换行后的名称,
+ * 逐步缩小边距直到名称能完整显示, 结果以项左上角为原点
+ * @param itemSize 项大小
+ * @param iconSize 图标大小
+ * @param fm 应用名称字体度量
+ * @param fontPixelSize 应用名称字体像素大小
+ * @param displayName 显示的应用名称
+ * @param drawBlueDot 是否绘制新安装应用的小蓝点
+ * @return 应用项布局
+ */
+ItemLayout AppItemDelegate::calcItemLayout(const QSize &itemSize, const QSize &iconSize, const QFontMetrics &fm,
+                                           const int fontPixelSize, const QString &displayName, const bool drawBlueDot) const
+{
+    const QRect itemBoundRect = itemBoundingRect(QRect(QPoint(0, 0), itemSize));
+    const static double x1 = 0.26418192;
+    const static double x2 = -0.38890932;
+    const double result = x1 * itemBoundRect.width() + x2 * iconSize.width();
+    int margin = result > 0 ? result * 0.71 : 1;
+
+    // adjust
+    QRect br;
+    QRect iconRect;
+    QRectF appNameRect;
+    QString appNameResolved;
+    bool adjust = false;
+    bool  TextSecond = 0;
+    do {
+        // adjust
+        if (adjust)
+            --margin;
+        br = itemBoundRect.marginsRemoved(QMargins(margin, 1, margin, margin * 2));
+
+        // calc icon rect
+        const int iconLeftMargins = (br.width() - iconSize.width()) / 2;
+        int iconTopMargin = ICONTOTOP;
+        iconRect = QRect(br.topLeft() + QPoint(iconLeftMargins, iconTopMargin - 2), iconSize);
+
+        //31是字体设置20的时候的高度
+        br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
+        if (br.height() > itemBoundRect.height())
+            br.setHeight(itemBoundRect.height() - 1);
+
+        // calc text
+        appNameRect = itemTextRect(br, iconRect, drawBlueDot);
+
+        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, displayName, appNameRect.toRect());
+        appNameResolved = appTextResolvedInfo.first;
+
+        if ((fm.width(appNameResolved) + (drawBlueDot ? (m_blueDotPixmap.width() + 10) : 0)) >= appNameRect.width())
+            TextSecond = 1;
+
+        if (margin == 1 || appTextResolvedInfo.second) {
+            br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
+            appNameRect = itemTextRect(br, iconRect, drawBlueDot);
+            break;
+        }
+
+        adjust = true;
+    } while (true);
+
+    appNameRect.setY(br.y() + br.height() - TEXTTOLEFT + (fm.height() >= 28 ? 2 : 0) - fm.height() - fontPixelSize * TextSecond);
+
+    if (drawBlueDot) {
+        appNameRect.setX(appNameRect.x() + m_blueDotPixmap.width() / 2 + 5);
+        appNameRect.setWidth(appNameRect.width() - m_blueDotPixmap.width());
+    }
+
+    ItemLayout layout;
+    layout.boundingRect = br;
+    layout.iconRect = iconRect;
+    layout.textRect = appNameRect;
+    layout.text = appNameResolved;
+    layout.textWidth = fm.width(appNameResolved);
+    if (drawBlueDot)
+        layout.blueDotTextRect = fm.boundingRect(appNameRect.toRect(), Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap, appNameResolved);
+
+    return layout;
+}
+
 QSize AppItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     Q_UNUSED(option)
@@ -295,33 +483,64 @@ const QPair<QString, bool> AppItemDelegate::holdTextInRect(const QFontMetrics &f
 /** 绘制应用文件夹
  * @brief AppItemDelegate::drawAppDrawer
  * @param painter 绘画师
- * @param index 应用模型索引
+ * @param index 应用模型索引, 缩略图缓存未命中时获取文件夹内应用的图标
+ * @param tileInfo 应用项数据
  * @param boundingRect 应用的边界矩形
  */
-void AppItemDelegate::drawAppDrawer(QPainter *painter, const QModelIndex &index, QRect iconRect) const
+void AppItemDelegate::drawAppDrawer(QPainter *painter, const QModelIndex &index, const AppTileInfo &tileInfo, QRect iconRect) const
 {
-    const bool itemIsDir = index.data(AppsListModel::ItemIsDirRole).toBool();
-    const ItemInfoList_v1 itemList = index.data(AppsListModel::DirItemInfoRole).value<ItemInfoList_v1>();
-    const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
+    const bool itemIsDir = tileInfo.isDir;
+    const ItemInfoList_v1 &itemList = tileInfo.info.m_appInfoList;
 
     // 读数据配置应用文件夹效果
     QRect AppdrawerRect = QRect(iconRect.topLeft(), iconRect.size());
     if (itemIsDir && !itemList.isEmpty()) {
-        QList<QPixmap> pixmapList = index.data(AppsListModel::DirAppIconsRole).value<QList<QPixmap>>();
-        painter->setPen(Qt::transparent);
-        painter->setBrush(QColor(93, 92, 90, 100));
-        painter->drawRoundedRect(AppdrawerRect, RECT_REDIUS, RECT_REDIUS);
-        // 绘制文件夹内其他应用
         // designer: show max to 4 icons
-        const int iconCount = qMin(4, itemList.size());
+        const int iconCount = qMin(DIR_THUMBNAIL_ICON_COUNT, itemList.size());
+        const qreal ratio = painter->device()->devicePixelRatioF();
+
+        DirThumbnailKey key;
+        key.desktop = tileInfo.info.m_desktop;
+        for (int i = 0; i < iconCount; i++) {
+            key.desktops << itemList.at(i).m_desktop;
+            key.iconKeys << itemList.at(i).m_iconKey;
+        }
+        key.size = AppdrawerRect.size();
+        key.ratio = ratio;
+
+        const QPixmap *cachedThumbnail = dirThumbnailCache().object(key);
+        if (cachedThumbnail) {
+            painter->drawPixmap(AppdrawerRect.topLeft(), *cachedThumbnail);
+            return;
+        }
+
+        // 文件夹内容或其中应用的图标变化后才重新合成
+        QPixmap thumbnail(AppdrawerRect.size() * ratio);
+        thumbnail.setDevicePixelRatio(ratio);
+        thumbnail.fill(Qt::transparent);
+
+        const QRect thumbnailRect(QPoint(0, 0), AppdrawerRect.size());
+        const QList<QPixmap> pixmapList = index.data(AppsListModel::DirAppIconsRole).value<QList<QPixmap>>();
+        const QPixmap iconPix = pixmapList.size() < iconCount ? index.data(AppsListModel::AppIconRole).value<QPixmap>() : QPixmap();
+
+        QPainter thumbnailPainter(&thumbnail);
+        thumbnailPainter.setRenderHints(painter->renderHints());
+        thumbnailPainter.setPen(Qt::transparent);
+        thumbnailPainter.setBrush(QColor(93, 92, 90, 100));
+        thumbnailPainter.drawRoundedRect(thumbnailRect, RECT_REDIUS, RECT_REDIUS);
+        // 绘制文件夹内其他应用
         for (int i = 0; i < iconCount; i++) {
             QPixmap itemPix = iconPix;
             if (i < pixmapList.size())
                 itemPix = pixmapList.at(i);
 
-            QRect sourceRect = appSourceRect(AppdrawerRect, i);
-            painter->drawPixmap(sourceRect, itemPix, itemPix.rect());
+            QRect sourceRect = appSourceRect(thumbnailRect, i);
+            thumbnailPainter.drawPixmap(sourceRect, itemPix, itemPix.rect());
         }
+        thumbnailPainter.end();
+
+        painter->drawPixmap(AppdrawerRect.topLeft(), thumbnail);
+        dirThumbnailCache().insert(key, new QPixmap(thumbnail), thumbnail.width() * thumbnail.height() * thumbnail.depth() / 8);
         return;
     }
 
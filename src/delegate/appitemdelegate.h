@@ -12,10 +12,81 @@
 #include <QModelIndex>
 #include <QStyleOptionViewItem>
 #include <QPainter>
+#include <QHash>
+#include <QCache>
 
 DGUI_USE_NAMESPACE
 
+/**
+ * @brief The ItemLayoutKey struct
+ * 应用项布局缓存的键
+ */
+struct ItemLayoutKey
+{
+    QString displayName;        // 显示的应用名称
+    QSize itemSize;             // 项大小
+    QSize iconSize;             // 图标大小
+    QString fontKey;            // 应用名称字体
+    bool blueDot;               // 是否绘制新安装应用的小蓝点
+
+    bool operator==(const ItemLayoutKey &other) const
+    {
+        return displayName == other.displayName && itemSize == other.itemSize && iconSize == other.iconSize
+                && fontKey == other.fontKey && blueDot == other.blueDot;
+    }
+};
+
+inline uint qHash(const ItemLayoutKey &key, uint seed = 0)
+{
+    return qHash(key.displayName, seed) ^ qHash(key.fontKey, seed)
+            ^ qHash(qMakePair(key.itemSize.width(), key.itemSize.height()), seed)
+            ^ qHash(qMakePair(key.iconSize.width(), key.iconSize.height()), seed + 1)
+            ^ uint(key.blueDot);
+}
+
+/**
+ * @brief The ItemTileKey struct
+ * 应用项绘制缓存的键
+ */
+struct ItemTileKey
+{
+    ItemLayoutKey layoutKey;    // 布局相关信息
+    QString desktop;            // 应用 desktop 文件路径
+    QString iconName;           // 应用图标名称, 图标主题或图标文件变化时整体清除
+    QStringList dirDesktops;    // 应用文件夹缩略图中显示的应用, 其中应用变化后缓存失效
+    bool autoStart;             // 是否绘制自启动角标
+    bool fullscreen;            // 是否为全屏模式
+    qreal ratio;                // 设备缩放比
+
+    bool operator==(const ItemTileKey &other) const
+    {
+        return layoutKey == other.layoutKey && desktop == other.desktop && iconName == other.iconName
+                && dirDesktops == other.dirDesktops && autoStart == other.autoStart && fullscreen == other.fullscreen && qFuzzyCompare(ratio, other.ratio);
+    }
+};
+
+inline uint qHash(const ItemTileKey &key, uint seed = 0)
+{
+    return qHash(key.layoutKey, seed) ^ qHash(key.desktop, seed) ^ qHash(key.iconName, seed + 2) ^ qHash(key.dirDesktops, seed + 1)
+            ^ (uint(key.autoStart) << 1) ^ (uint(key.fullscreen) << 2);
+}
+
+/**
+ * @brief The ItemLayout struct
+ * 应用项布局, 以项左上角为原点
+ */
+struct ItemLayout
+{
+    QRect boundingRect;         // 选中背景区域
+    QRect iconRect;             // 图标区域
+    QRectF textRect;            // 应用名称区域
+    QRectF blueDotTextRect;     // 小蓝点定位使用的名称实际区域
+    QString text;               // 换行或省略后的应用名称
+    int textWidth;              // 应用名称单行宽度
+};
+
 class CalculateUtil;
+struct AppTileInfo;
 class AppItemDelegate : public QAbstractItemDelegate
 {
     Q_OBJECT
@@ -28,7 +99,7 @@ public:
     void setDirModelIndex(QModelIndex dragIndex, QModelIndex dropIndex);
     void setItemList(const ItemInfoList_v1 &items);
     QRect appSourceRect(QRect rect, int index) const;
-    void drawAppDrawer(QPainter *painter, const QModelIndex &index, QRect iconRect) const;
+    void drawAppDrawer(QPainter *painter, const QModelIndex &index, const AppTileInfo &tileInfo, QRect iconRect) const;
 
 signals:
     void requestUpdate(const QModelIndex &idx) const;
@@ -41,6 +112,15 @@ private:
     const QRect itemBoundingRect(const QRect &itemRect) const;
     const QRect itemTextRect(const QRect &boundingRect, const QRect &iconRect, const bool extraWidthMargin) const;
     const QPair<QString, bool> holdTextInRect(const QFontMetrics &fm, const QString &text, const QRect &rect) const;
+    ItemLayout calcItemLayout(const QSize &itemSize, const QSize &iconSize, const QFontMetrics &fm,
+                              const int fontPixelSize, const QString &displayName, const bool drawBlueDot) const;
+
+    void drawItemContent(QPainter *painter, const QModelIndex &index, const AppTileInfo &tileInfo, const ItemLayout &layout,
+                         const QPoint &offset, const QFont &appNamefont) const;
+
+private slots:
+    void clearCache();
+    void removeItemCache(const ItemInfo_v1 &info);
 
 private:
     CalculateUtil *m_calcUtil;
@@ -51,6 +131,8 @@ private:
     QModelIndex m_dragIndex;
     QModelIndex m_dropIndex;
     ItemInfoList_v1 m_itemList;
+    mutable QHash<ItemLayoutKey, ItemLayout> m_layoutCache;    // 应用项布局缓存
+    mutable QCache<ItemTileKey, QPixmap> m_tileCache;           // 应用项图标、名称及角标的绘制缓存, 按字节计算开销
 };
 
 #endif // APPITEMDELEGATE_H
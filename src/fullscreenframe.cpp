@@ -120,7 +120,7 @@ void FullScreenFrame::addViewEvent(AppGridView *pView)
     connect(pView, &AppGridView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
     connect(pView, &AppGridView::clicked, this, &FullScreenFrame::onAppClick);
     connect(pView, &AppGridView::requestMouseRelease, this, &FullScreenFrame::onRequestMouseRelease);
-    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<>(&AppGridView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<const QModelIndex &>(&AppGridView::update));
 }
 
 void FullScreenFrame::onHideMenu()
@@ -135,7 +135,7 @@ void FullScreenFrame::onDrawerClick(AppGridView *pView)
     connect(pView, &AppGridView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
     connect(pView, &AppGridView::clicked, this, &FullScreenFrame::onDrawerAppClick);
     connect(pView, &AppGridView::requestMouseRelease, this, &FullScreenFrame::onRequestMouseRelease);
-    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<>(&AppGridView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<const QModelIndex &>(&AppGridView::update));
 }
 
 void FullScreenFrame::showTips(const QString &tips)
@@ -897,7 +897,7 @@ void FullScreenFrame::mouseReleaseDrag(QMouseEvent *e)
        int nScroll = m_multiPagesView->getListArea()->horizontalScrollBar()->value();
         //多个分页是点击直接隐藏
         if (nScroll == m_scrollStart && curPage != 1)
-            emit m_multiPagesView->getAppGridViewList()[curPage]->clicked(QModelIndex());
+            emit m_multiPagesView->pageView(curPage)->clicked(QModelIndex());
         else if (nScroll - m_scrollStart > DLauncher::MOUSE_MOVE_TO_NEXT)
             m_multiPagesView->showCurrentPage(curPage + 1);
         else if (nScroll - m_scrollStart < -DLauncher::MOUSE_MOVE_TO_NEXT)
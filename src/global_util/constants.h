@@ -80,6 +80,7 @@ static const QString UNABLE_TO_DOCK_LIST = "unable-to-dock-list";
 static const QString SHOW_LINGLONG_SUFFIX = "show-linglong-suffix-name";            // 显示玲珑应用后缀
 static const QString USE_SOLID_BACKGROUND = "use-solid-background";                 // 启动器全屏模式使用纯色背景
 static const QString ENABLE_FULL_SCREEN_MODE = "enable-full-screen-mode";           // 是否支持切换到全屏模式
+static const QString APPS_DISABLE_SCALING = "Apps_Disable_Scaling";                 // 禁用缩放的应用列表
 
 static const int MOUSE_LEFTBUTTON = 1;
 static const int MOUSE_RIGHTBUTTON  = 3;
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stringpool.h"
+
+#include <QSet>
+#include <QMutex>
+#include <QMutexLocker>
+
+static QSet<QString> &stringPool()
+{
+    static QSet<QString> pool;
+    return pool;
+}
+
+static QMutex &stringPoolMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief StringPool::intern 获取字符串在驻留池中的唯一副本
+ * 驻留的字符串数量与应用数量相当, 驻留后不再释放
+ * @param str 需要驻留的字符串
+ * @return 与 str 内容相同且共享数据的字符串
+ */
+QString StringPool::intern(const QString &str)
+{
+    if (str.isEmpty())
+        return str;
+
+    QMutexLocker locker(&stringPoolMutex());
+
+    QSet<QString> &pool = stringPool();
+    auto it = pool.constFind(str);
+    if (it != pool.constEnd())
+        return *it;
+
+    pool.insert(str);
+    return str;
+}
+
+int StringPool::size()
+{
+    QMutexLocker locker(&stringPoolMutex());
+    return stringPool().size();
+}
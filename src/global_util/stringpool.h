@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <QString>
+
+/**
+ * @brief The StringPool class 标识字符串驻留池
+ * desktop 路径、应用 key、图标名称等标识在各列表、缓存中大量重复,
+ * 驻留后相同的标识共享同一份字符串数据, 只用于减少内存占用, 比较时仍按内容比较
+ */
+class StringPool
+{
+public:
+    static QString intern(const QString &str);
+    static int size();
+};
+
+#endif // STRINGPOOL_H
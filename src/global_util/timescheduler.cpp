@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "timescheduler.h"
+
+#include <QDebug>
+#include <QTimer>
+#include <QDateTime>
+#include <QSocketNotifier>
+#include <QDBusConnection>
+
+#include <algorithm>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+// 零点后稍作延迟, 避免系统时钟精度导致日期尚未切换
+static const int DATE_CHANGE_MARGIN = 1000;
+static const qint64 MSECS_PER_HOUR = 60 * 60 * 1000;
+
+QPointer<TimeScheduler> TimeScheduler::INSTANCE = nullptr;
+
+TimeScheduler *TimeScheduler::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new TimeScheduler(nullptr);
+
+    return INSTANCE;
+}
+
+TimeScheduler::TimeScheduler(QObject *parent)
+    : QObject(parent)
+    , m_launcherVisible(false)
+    , m_lastDate(QDate::currentDate())
+    , m_clockFd(timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC))
+    , m_clockNotifier(nullptr)
+    , m_dateTimer(new QTimer(this))
+    , m_clock(&QDateTime::currentMSecsSinceEpoch)
+{
+    m_dateTimer->setSingleShot(true);
+    m_dateTimer->setTimerType(Qt::VeryCoarseTimer);
+
+    if (m_clockFd != -1) {
+        m_clockNotifier = new QSocketNotifier(m_clockFd, QSocketNotifier::Read, this);
+        m_clockNotifier->setEnabled(false);
+        connect(m_clockNotifier, &QSocketNotifier::activated, this, &TimeScheduler::onClockNotifierActivated);
+    } else {
+        qWarning() << "timerfd_create failed, fallback to QTimer, errno:" << errno;
+    }
+
+    connect(m_dateTimer, &QTimer::timeout, this, [ this ] {
+        recordWakeup();
+        checkDate();
+    });
+
+    // 时区变化后本地零点随之改变, 需要重新校验
+    QDBusConnection::systemBus().connect("org.freedesktop.timedate1", "/org/freedesktop/timedate1",
+                                         "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                         this, SLOT(onTimedatePropertiesChanged(QString, QVariantMap, QStringList)));
+}
+
+TimeScheduler::~TimeScheduler()
+{
+    if (m_clockFd != -1)
+        close(m_clockFd);
+}
+
+/**
+ * @brief TimeScheduler::setLauncherVisible 启动器显示时校验日期并启动零点定时, 隐藏时停止所有计时
+ * @param visible 启动器是否可见
+ */
+void TimeScheduler::setLauncherVisible(const bool visible)
+{
+    if (m_launcherVisible == visible)
+        return;
+
+    m_launcherVisible = visible;
+
+    if (visible) {
+        checkDate();
+    } else {
+        disarmDateTimer();
+        qDebug() << "time scheduler wakeups per hour:" << wakeupsPerHour();
+    }
+}
+
+/**
+ * @brief TimeScheduler::wakeupsPerHour
+ * @return 最近一小时内调度器的唤醒次数
+ */
+int TimeScheduler::wakeupsPerHour() const
+{
+    const qint64 now = m_clock();
+    return int(std::count_if(m_wakeupTimes.cbegin(), m_wakeupTimes.cend(), [ now ](const qint64 wakeupTime) {
+        return now - wakeupTime <= MSECS_PER_HOUR;
+    }));
+}
+
+/**
+ * @brief TimeScheduler::setClock 替换统计唤醒次数使用的时钟
+ * @param clock 返回当前时间(毫秒)的函数
+ */
+void TimeScheduler::setClock(const std::function<qint64()> &clock)
+{
+    m_clock = clock;
+}
+
+/**
+ * @brief TimeScheduler::armDateTimer 将定时器对齐到下一个本地零点
+ */
+void TimeScheduler::armDateTimer()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDateTime nextDate(now.date().addDays(1), QTime(0, 0));
+
+    if (m_clockFd != -1) {
+        // 绝对时间定时, 系统时间被修改时 read 返回 ECANCELED
+        const qint64 expireMSecs = nextDate.toMSecsSinceEpoch() + DATE_CHANGE_MARGIN;
+        struct itimerspec spec = {};
+        spec.it_value.tv_sec = expireMSecs / 1000;
+        spec.it_value.tv_nsec = (expireMSecs % 1000) * 1000000;
+
+        if (timerfd_settime(m_clockFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, nullptr) == 0) {
+            m_clockNotifier->setEnabled(true);
+            return;
+        }
+
+        qWarning() << "timerfd_settime failed, fallback to QTimer, errno:" << errno;
+    }
+
+    m_dateTimer->start(int(now.msecsTo(nextDate)) + DATE_CHANGE_MARGIN);
+}
+
+void TimeScheduler::disarmDateTimer()
+{
+    if (m_clockFd != -1) {
+        const struct itimerspec spec = {};
+        timerfd_settime(m_clockFd, 0, &spec, nullptr);
+        m_clockNotifier->setEnabled(false);
+    }
+
+    m_dateTimer->stop();
+}
+
+void TimeScheduler::recordWakeup()
+{
+    const qint64 now = m_clock();
+    m_wakeupTimes.enqueue(now);
+
+    // 顺便清理一小时之前的记录
+    while (now - m_wakeupTimes.head() > MSECS_PER_HOUR)
+        m_wakeupTimes.dequeue();
+}
+
+/**
+ * @brief TimeScheduler::checkDate 日期与上次校验不同时发送 dateChanged 信号, 启动器可见时重新对齐到下一个零点
+ */
+void TimeScheduler::checkDate()
+{
+    const QDate currentDate = QDate::currentDate();
+    if (m_lastDate != currentDate) {
+        m_lastDate = currentDate;
+        emit dateChanged(currentDate);
+    }
+
+    disarmDateTimer();
+
+    if (m_launcherVisible)
+        armDateTimer();
+}
+
+void TimeScheduler::onClockNotifierActivated()
+{
+    recordWakeup();
+
+    // 读取以清除可读状态, 到期或系统时间被修改(ECANCELED)都需要重新校验
+    quint64 expirations = 0;
+    if (read(m_clockFd, &expirations, sizeof(expirations)) == -1 && errno == EAGAIN)
+        return;
+
+    checkDate();
+}
+
+void TimeScheduler::onTimedatePropertiesChanged(const QString &interfaceName, const QVariantMap &changedProperties, const QStringList &invalidatedProperties)
+{
+    Q_UNUSED(interfaceName);
+
+    if (!changedProperties.contains("Timezone") && !invalidatedProperties.contains("Timezone"))
+        return;
+
+    recordWakeup();
+    checkDate();
+}
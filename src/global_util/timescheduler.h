@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TIMESCHEDULER_H
+#define TIMESCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QDate>
+#include <QQueue>
+#include <QVariantMap>
+
+#include <functional>
+
+class QTimer;
+class QSocketNotifier;
+
+/**
+ * @brief The TimeScheduler class
+ * 日期变化调度器, 在下一个零点、时区或系统时间变化时才唤醒,
+ * 启动器不可见时暂停计时, 重新显示时再校验日期
+ */
+class TimeScheduler : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void dateChanged(const QDate &date);
+
+public:
+    static TimeScheduler *instance();
+
+    void setLauncherVisible(const bool visible);
+    inline bool launcherVisible() const { return m_launcherVisible; }
+
+    int wakeupsPerHour() const;
+    void setClock(const std::function<qint64()> &clock);
+
+private:
+    explicit TimeScheduler(QObject *parent = nullptr);
+    ~TimeScheduler() override;
+
+    void armDateTimer();
+    void disarmDateTimer();
+    void recordWakeup();
+
+private slots:
+    void checkDate();
+    void onClockNotifierActivated();
+    void onTimedatePropertiesChanged(const QString &interfaceName, const QVariantMap &changedProperties, const QStringList &invalidatedProperties);
+
+private:
+    static QPointer<TimeScheduler> INSTANCE;
+
+    bool m_launcherVisible;                                 // 是否有启动器窗口可见
+    QDate m_lastDate;                                       // 上次校验时的日期
+    int m_clockFd;                                          // timerfd, 到达零点或系统时间被修改时可读
+    QSocketNotifier *m_clockNotifier;
+    QTimer *m_dateTimer;                                    // timerfd 不可用时的零点定时器
+    QQueue<qint64> m_wakeupTimes;                           // 最近一小时内的唤醒时间戳
+    std::function<qint64()> m_clock;                        // 当前时间(毫秒), 测试时可替换
+};
+
+#endif // TIMESCHEDULER_H
@@ -19,38 +19,126 @@
 #include <QIcon>
 #include <QScopedPointer>
 #include <QIconEngine>
+#include <QCache>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QFileSystemWatcher>
 
 
 DWIDGET_USE_NAMESPACE
 
-const QPixmap loadSvg(const QString &fileName, const int size)
+// SVG 栅格化结果的缓存上限(字节)
+static const int MAX_SVG_PIXMAP_CACHE_COST = 16 * 1024 * 1024;
+
+// 已解析的 SVG 文档数量上限
+static const int MAX_SVG_RENDERER_CACHE_COUNT = 128;
+
+static QCache<QString, QSvgRenderer> &svgRendererCache()
 {
-    if (!QFileInfo::exists(fileName))
-        return QPixmap();
+    static QCache<QString, QSvgRenderer> cache(MAX_SVG_RENDERER_CACHE_COUNT);
+    return cache;
+}
+
+static QCache<QString, QPixmap> &svgPixmapCache()
+{
+    static QCache<QString, QPixmap> cache(MAX_SVG_PIXMAP_CACHE_COST);
+    return cache;
+}
+
+/**
+ * @brief svgFileWatcher 监听已解析的非资源 SVG 文件, 文件变化后清除其解析及栅格化结果
+ * @return 进程内共享的文件监听对象
+ */
+static QFileSystemWatcher *svgFileWatcher()
+{
+    static QFileSystemWatcher *watcher = nullptr;
+    if (!watcher) {
+        watcher = new QFileSystemWatcher(qApp);
+        QObject::connect(watcher, &QFileSystemWatcher::fileChanged, [](const QString &fileName) {
+            svgRendererCache().remove(fileName);
+
+            const QString prefix = fileName + QLatin1Char('_');
+            for (const QString &key : svgPixmapCache().keys()) {
+                if (key.startsWith(prefix))
+                    svgPixmapCache().remove(key);
+            }
+        });
+    }
+
+    return watcher;
+}
+
+/**
+ * @brief svgPixmap 从进程内共享的缓存中获取栅格化后的 SVG 图片,
+ * 每个文件只解析一次, 解析结果用于栅格化不同大小的图片
+ * @param fileName 图片路径
+ * @param pixelSize 栅格化后的大小(物理像素)
+ * @param ratio 图片的设备像素比
+ * @param color 着色颜色, 无效时保持原色
+ * @return 栅格化后的图片
+ */
+static QPixmap svgPixmap(const QString &fileName, const QSize &pixelSize, const qreal ratio, const QColor &color = QColor())
+{
+    // 命中缓存时不访问文件系统, 非资源文件的更新由 svgFileWatcher 清除对应缓存
+    const QString pixmapKey = QString("%1_%2x%3_%4_%5").arg(fileName).arg(pixelSize.width()).arg(pixelSize.height())
+            .arg(ratio).arg(color.isValid() ? color.name(QColor::HexArgb) : QString());
+
+    const QPixmap *cachedPixmap = svgPixmapCache().object(pixmapKey);
+    if (cachedPixmap)
+        return *cachedPixmap;
+
+    QSvgRenderer *renderer = svgRendererCache().object(fileName);
+    if (!renderer) {
+        if (!QFileInfo::exists(fileName))
+            return QPixmap();
+
+        // 资源文件不会变化, 无需监听
+        if (!fileName.startsWith(QLatin1String(":/")) && !svgFileWatcher()->files().contains(fileName))
+            svgFileWatcher()->addPath(fileName);
+
+        renderer = new QSvgRenderer(fileName);
+        svgRendererCache().insert(fileName, renderer);
+    }
 
-    QPixmap pixmap(size, size);
-    QSvgRenderer renderer(fileName);
+    QPixmap pixmap(pixelSize);
     pixmap.fill(Qt::transparent);
 
     QPainter painter;
     painter.begin(&pixmap);
     painter.setRenderHint(QPainter::Antialiasing, true);
-    renderer.render(&painter);
+    renderer->render(&painter);
+    if (color.isValid()) {
+        painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+        painter.fillRect(pixmap.rect(), color);
+    }
     painter.end();
 
-    pixmap.setDevicePixelRatio(qRound(qApp->devicePixelRatio()));
+    pixmap.setDevicePixelRatio(ratio);
+
+    const int cost = pixelSize.width() * pixelSize.height() * 4;
+    svgPixmapCache().insert(pixmapKey, new QPixmap(pixmap), cost);
 
     return pixmap;
 }
 
+const QPixmap loadSvg(const QString &fileName, const int size)
+{
+    return svgPixmap(fileName, QSize(size, size), qRound(qApp->devicePixelRatio()));
+}
+
 /**
  * @brief renderSVG 根据实体屏幕渲染指定路径、指定大小的图片
  * @param path 渲染图片的路径
  * @param size 渲染图片的大小
+ * @param color 着色颜色, 无效时保持原色(仅对 SVG 图片生效)
  * @return 返回渲染后的pixmap
  */
-const QPixmap renderSVG(const QString &path, const QSize &size)
+const QPixmap renderSVG(const QString &path, const QSize &size, const QColor &color)
 {
+    const qreal ratio = qApp->devicePixelRatio();
+    if (path.endsWith(".svg", Qt::CaseInsensitive))
+        return svgPixmap(path, size * ratio, ratio, color);
+
     if (!QFileInfo::exists(path))
         return QPixmap();
 
@@ -58,7 +146,6 @@ const QPixmap renderSVG(const QString &path, const QSize &size)
     QPixmap pixmap;
     reader.setFileName(path);
     if (reader.canRead()) {
-        const qreal ratio = qApp->devicePixelRatio();
         reader.setScaledSize(size * ratio);
         pixmap = QPixmap::fromImage(reader.read());
         pixmap.setDevicePixelRatio(ratio);
@@ -72,19 +159,7 @@ const QPixmap renderSVG(const QString &path, const QSize &size)
 
 const QPixmap loadSvg(const QString &fileName, const QSize &size)
 {
-    if (!QFileInfo::exists(fileName))
-         return QPixmap();
-
-    QPixmap pixmap(size);
-    QSvgRenderer renderer(fileName);
-    pixmap.fill(Qt::transparent);
-
-    QPainter painter;
-    painter.begin(&pixmap);
-    renderer.render(&painter);
-    painter.end();
-
-    return pixmap;
+    return svgPixmap(fileName, size, 1);
 }
 
 /**
@@ -164,7 +239,7 @@ QVariant SettingValue(const QString &schema_id, const QByteArray &path, const QS
     }
 }
 
-bool createCalendarIcon(const QString &fileName)
+static QByteArray calendarIconData(const QDate &date)
 {
     static const QByteArrayList &dayList= {  "<polygon id=\"path-5\" points=\"50.2401631 67.0997814 50.2401631 37.9113049 46.0560811 37.9113049 41.9120381 40.9342541 41.9120381 45.37859 46.0560811 42.3356213 46.0560811 67.0997814\"></polygon>\n"
                                             , "<path d=\"M56.0328614,66.8683044 L56.0328614,62.6842223 L44.8819825,62.6842223 L54.2711427,50.912738 C55.4456218,49.4179463 56.0328614,47.709613 56.0328614,45.787738 C56.0061687,43.3853942 55.1987143,41.4034606 53.6104981,39.8419372 C52.0489747,38.2670674 50.0136557,37.4662861 47.5045411,37.4395934 C45.2623536,37.4662861 43.3738445,38.253721 41.8390138,39.8018981 C40.3175294,41.3901143 39.5034018,43.3987406 39.3966309,45.827777 L43.5606934,45.827777 C43.7075033,44.4931416 44.1746257,43.4587992 44.9620606,42.7247497 C45.7228028,41.9907002 46.6770671,41.6236755 47.8248536,41.6236755 C49.11945,41.6503682 50.1204265,42.0707783 50.8277833,42.8849059 C51.5084473,43.6990335 51.8487794,44.6532979 51.8487794,45.7476989 C51.8487794,46.1614359 51.795394,46.6018656 51.6886231,47.068988 C51.5284669,47.5628031 51.2281739,48.0966572 50.7877442,48.6705505 L39.3966309,62.9244567 L39.3966309,66.8683044 L56.0328614,66.8683044 Z\" id=\"path-5\"></path>\n"
@@ -221,70 +296,104 @@ bool createCalendarIcon(const QString &fileName)
                                              , "<path d=\"M48.2793422,79.0910854 C49.4868422,79.0910854 50.2218422,78.3710854 50.2218422,77.4860854 C50.2218422,76.6760854 49.7493422,76.2710854 49.0968422,75.9935854 L48.3393422,75.6710854 C47.8893422,75.4910854 47.4468422,75.3110854 47.4468422,74.8310854 C47.4468422,74.3960854 47.8143422,74.1260854 48.3768422,74.1260854 C48.8643422,74.1260854 49.2468422,74.3135854 49.5918422,74.6210854 L50.0493422,74.0660854 C49.6293422,73.6385854 49.0218422,73.3685854 48.3768422,73.3685854 C47.3268422,73.3685854 46.5618422,74.0210854 46.5618422,74.8910854 C46.5618422,75.6935854 47.1543422,76.1135854 47.6868422,76.3385854 L48.4518422,76.6685854 C48.9618422,76.8935854 49.3368422,77.0510854 49.3368422,77.5535854 C49.3368422,78.0185854 48.9618422,78.3335854 48.2943422,78.3335854 C47.7618422,78.3335854 47.2218422,78.0785854 46.8243422,77.6810854 L46.3143422,78.2810854 C46.8168422,78.7910854 47.5218422,79.0910854 48.2793422,79.0910854 Z M51.4218422,78.9935854 L51.8943422,77.4185854 L53.8143422,77.4185854 L54.2793422,78.9935854 L55.2018422,78.9935854 L53.3718422,73.4660854 L52.3668422,73.4660854 L50.5368422,78.9935854 L51.4218422,78.9935854 Z M53.6043422,76.7360854 L52.0968422,76.7360854 L52.3218422,75.9935854 C52.5018422,75.3935854 52.6743422,74.7860854 52.8318422,74.1560854 L52.8693422,74.1560854 C53.0343422,74.7785854 53.1993422,75.3935854 53.3868422,75.9935854 L53.6043422,76.7360854 Z M57.9243422,78.9935854 L57.9243422,74.2010854 L59.5518422,74.2010854 L59.5518422,73.4660854 L55.4343422,73.4660854 L55.4343422,74.2010854 L57.0543422,74.2010854 L57.0543422,78.9935854 L57.9243422,78.9935854 Z\" id=\"SAT\" fill=\"#2D394F\" fill-rule=\"nonzero\" transform=\"translate(52.933092, 76.229835) rotate(-8.000000) translate(-52.933092, -76.229835) \"></path>\n"
                                              , "<path d=\"M48.2732111,79.0034064 C49.4807111,79.0034064 50.2157111,78.2834064 50.2157111,77.3984064 C50.2157111,76.5884064 49.7432111,76.1834064 49.0907111,75.9059064 L48.3332111,75.5834064 C47.8832111,75.4034064 47.4407111,75.2234064 47.4407111,74.7434064 C47.4407111,74.3084064 47.8082111,74.0384064 48.3707111,74.0384064 C48.8582111,74.0384064 49.2407111,74.2259064 49.5857111,74.5334064 L50.0432111,73.9784064 C49.6232111,73.5509064 49.0157111,73.2809064 48.3707111,73.2809064 C47.3207111,73.2809064 46.5557111,73.9334064 46.5557111,74.8034064 C46.5557111,75.6059064 47.1482111,76.0259064 47.6807111,76.2509064 L48.4457111,76.5809064 C48.9557111,76.8059064 49.3307111,76.9634064 49.3307111,77.4659064 C49.3307111,77.9309064 48.9557111,78.2459064 48.2882111,78.2459064 C47.7557111,78.2459064 47.2157111,77.9909064 46.8182111,77.5934064 L46.3082111,78.1934064 C46.8107111,78.7034064 47.5157111,79.0034064 48.2732111,79.0034064 Z M53.2832111,79.0034064 C54.5057111,79.0034064 55.3307111,78.3359064 55.3307111,76.5359064 L55.3307111,73.3784064 L54.4907111,73.3784064 L54.4907111,76.5959064 C54.4907111,77.8409064 53.9807111,78.2459064 53.2832111,78.2459064 C52.5932111,78.2459064 52.0982111,77.8409064 52.0982111,76.5959064 L52.0982111,73.3784064 L51.2282111,73.3784064 L51.2282111,76.5359064 C51.2282111,78.3359064 52.0607111,79.0034064 53.2832111,79.0034064 Z M57.5807111,78.9059064 L57.5807111,76.3034064 C57.5807111,75.7034064 57.5132111,75.0659064 57.4682111,74.4959064 L57.5057111,74.4959064 L58.0832111,75.6509064 L59.9132111,78.9059064 L60.8057111,78.9059064 L60.8057111,73.3784064 L59.9807111,73.3784064 L59.9807111,75.9584064 C59.9807111,76.5584064 60.0482111,77.2259064 60.0932111,77.7959064 L60.0557111,77.7959064 L59.4782111,76.6259064 L57.6482111,73.3784064 L56.7557111,73.3784064 L56.7557111,78.9059064 L57.5807111,78.9059064 Z\" id=\"SUN\" fill=\"#2D394F\" fill-rule=\"nonzero\" transform=\"translate(53.556961, 76.142156) rotate(-8.000000) translate(-53.556961, -76.142156) \"></path>\n"};
 
-    if (!QFile(fileName).exists()) {
-        // create svg
-        QFile file(fileName);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
-            return false;
-
-        file.write(QByteArray("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
-                              "<svg width=\"96px\" height=\"96px\" viewBox=\"0 0 96 96\" version=\"1.1\" xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">\n"
-                              "    <title>0101</title>\n"
-                              "    <defs>\n"
-                              "        <radialGradient cx=\"54.3240802%\" cy=\"55.7793187%\" fx=\"54.3240802%\" fy=\"55.7793187%\" r=\"61.9689111%\" gradientTransform=\"translate(0.543241,0.557793),scale(1.000000,0.880000),rotate(-144.926693),scale(1.000000,1.264710),translate(-0.543241,-0.557793)\" id=\"radialGradient-1\">\n"
-                              "            <stop stop-color=\"#000000\" offset=\"0%\"></stop>\n"
-                              "            <stop stop-color=\"#000000\" stop-opacity=\"0.148218969\" offset=\"100%\"></stop>\n"
-                              "        </radialGradient>\n"
-                              "        <linearGradient x1=\"69.7602459%\" y1=\"71.0965544%\" x2=\"56.9833471%\" y2=\"57.7013487%\" id=\"linearGradient-2\">\n"
-                              "            <stop stop-color=\"#C6C6C6\" offset=\"0%\"></stop>\n"
-                              "            <stop stop-color=\"#E7E7E7\" offset=\"53.0517663%\"></stop>\n"
-                              "            <stop stop-color=\"#F4F4F4\" offset=\"100%\"></stop>\n"
-                              "        </linearGradient>\n"
-                              "        <path d=\"M24.6973331,1.47397555 C24.6973331,1.47397555 23.4967197,8.18936447 22.1348331,10.3802256 C19.9785831,13.8489756 18.3848331,12.5364756 15.3848331,16.1927256 C12.3848331,19.8489756 14.4473331,20.5052256 9.9473331,24.3489756 C7.53576878,26.4088534 1.6973331,27.4739756 1.6973331,27.4739756 C20.3535831,27.4739756 24.6973331,11.5052256 24.6973331,1.47397555 Z\" id=\"path-3\"></path>\n"
-                              "        <filter x=\"-8.7%\" y=\"-3.8%\" width=\"117.4%\" height=\"115.4%\" filterUnits=\"objectBoundingBox\" id=\"filter-4\">\n"
-                              "            <feOffset dx=\"0\" dy=\"1\" in=\"SourceAlpha\" result=\"shadowOffsetOuter1\"></feOffset>\n"
-                              "            <feGaussianBlur stdDeviation=\"0.5\" in=\"shadowOffsetOuter1\" result=\"shadowBlurOuter1\"></feGaussianBlur>\n"
-                              "            <feColorMatrix values=\"0 0 0 0 0   0 0 0 0 0   0 0 0 0 0  0 0 0 0.05 0\" type=\"matrix\" in=\"shadowBlurOuter1\"></feColorMatrix>\n"
-                              "        </filter>\n"));
-        // 日期
-        file.write("        " + dayList.at(QDate::currentDate().day() - 1));
-        file.write(QByteArray("        <filter x=\"-84.1%\" y=\"-17.1%\" width=\"268.1%\" height=\"148.0%\" filterUnits=\"objectBoundingBox\" id=\"filter-6\">\n"
-                              "                <feOffset dx=\"0\" dy=\"2\" in=\"SourceAlpha\" result=\"shadowOffsetOuter1\"></feOffset>\n"
-                              "                <feGaussianBlur stdDeviation=\"2\" in=\"shadowOffsetOuter1\" result=\"shadowBlurOuter1\"></feGaussianBlur>\n"
-                              "                <feColorMatrix values=\"0 0 0 0 0.000854821203   0 0 0 0 0.168099661   0 0 0 0 0.309386322  0 0 0 0.2 0\" type=\"matrix\" in=\"shadowBlurOuter1\"></feColorMatrix>\n"
-                              "        </filter>\n"
-                              "    </defs>\n"
-                              "    <g id=\"0101\" stroke=\"none\" stroke-width=\"1\" fill=\"none\" fill-rule=\"evenodd\">\n"
-                              "        <rect id=\"矩形备份-2\" fill=\"#FFFFFF\" transform=\"translate(48.000000, 48.000000) rotate(-8.000000) translate(-48.000000, -48.000000) \" x=\"8\" y=\"8\" width=\"80\" height=\"80\" rx=\"14.625\"></rect>\n"
-                              "        <g id=\"编组\" transform=\"translate(66.782981, 56.296829)\">\n"));
-        // 右下角
-        file.write(QByteArray("        <path d=\"M24.7611755,2.4045457 L24.7620537,12.774523 C24.7620537,20.8516875 18.2142182,27.399523 10.1370537,27.399523 L2.76205369,27.399523 C10.2787204,26.4804054 15.5648315,23.5698662 18.620387,18.6679054 C21.6750819,13.7673254 23.7220114,8.34620554 24.7611755,2.4045457 Z\" id=\"形状结合\" fill-opacity=\"0.39\" fill=\"url(#radialGradient-1)\" transform=\"translate(13.762054, 14.899523) rotate(-8.000000) translate(-13.762054, -14.899523) \"></path>\n"));
-
-        // 背景
-        file.write(QByteArray("            <g id=\"路径-11\" transform=\"translate(13.197333, 14.473976) rotate(-8.000000) translate(-13.197333, -14.473976) \">\n"
-                              "                <use fill=\"black\" fill-opacity=\"1\" filter=\"url(#filter-4)\" xlink:href=\"#path-3\"></use>\n"
-                              "                <use fill=\"url(#linearGradient-2)\" fill-rule=\"evenodd\" xlink:href=\"#path-3\"></use>\n"
-                              "            </g>\n"
-                              "        </g>\n"));
-        // 月份
-        file.write("        " + monthList.at(QDate::currentDate().month() - 1));
-        // 日期
-        file.write(QByteArray("        <g id=\"1\" fill-rule=\"nonzero\" transform=\"translate(46.076101, 52.505543) rotate(-8.000000) translate(-46.076101, -52.505543) \">\n"
-                              "            <use fill=\"black\" fill-opacity=\"1\" filter=\"url(#filter-6)\" xlink:href=\"#path-5\"></use>\n"
-                              "            <use fill=\"#2D394F\" xlink:href=\"#path-5\"></use>\n"
-                              "            <use fill=\"#2D394F\" xlink:href=\"#path-5\"></use>\n"
-                              "        </g>\n"));
-        // 星期
-        file.write("        " + weekList.at(QDate::currentDate().dayOfWeek() - 1));
-
-        // 右下角
-        file.write(QByteArray("    </g>\n"
-                              "</svg>"));
-
-        file.close();
+    QByteArray data;
+
+    data.append(QByteArray("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                           "<svg width=\"96px\" height=\"96px\" viewBox=\"0 0 96 96\" version=\"1.1\" xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">\n"
+                           "    <title>0101</title>\n"
+                           "    <defs>\n"
+                           "        <radialGradient cx=\"54.3240802%\" cy=\"55.7793187%\" fx=\"54.3240802%\" fy=\"55.7793187%\" r=\"61.9689111%\" gradientTransform=\"translate(0.543241,0.557793),scale(1.000000,0.880000),rotate(-144.926693),scale(1.000000,1.264710),translate(-0.543241,-0.557793)\" id=\"radialGradient-1\">\n"
+                           "            <stop stop-color=\"#000000\" offset=\"0%\"></stop>\n"
+                           "            <stop stop-color=\"#000000\" stop-opacity=\"0.148218969\" offset=\"100%\"></stop>\n"
+                           "        </radialGradient>\n"
+                           "        <linearGradient x1=\"69.7602459%\" y1=\"71.0965544%\" x2=\"56.9833471%\" y2=\"57.7013487%\" id=\"linearGradient-2\">\n"
+                           "            <stop stop-color=\"#C6C6C6\" offset=\"0%\"></stop>\n"
+                           "            <stop stop-color=\"#E7E7E7\" offset=\"53.0517663%\"></stop>\n"
+                           "            <stop stop-color=\"#F4F4F4\" offset=\"100%\"></stop>\n"
+                           "        </linearGradient>\n"
+                           "        <path d=\"M24.6973331,1.47397555 C24.6973331,1.47397555 23.4967197,8.18936447 22.1348331,10.3802256 C19.9785831,13.8489756 18.3848331,12.5364756 15.3848331,16.1927256 C12.3848331,19.8489756 14.4473331,20.5052256 9.9473331,24.3489756 C7.53576878,26.4088534 1.6973331,27.4739756 1.6973331,27.4739756 C20.3535831,27.4739756 24.6973331,11.5052256 24.6973331,1.47397555 Z\" id=\"path-3\"></path>\n"
+                           "        <filter x=\"-8.7%\" y=\"-3.8%\" width=\"117.4%\" height=\"115.4%\" filterUnits=\"objectBoundingBox\" id=\"filter-4\">\n"
+                           "            <feOffset dx=\"0\" dy=\"1\" in=\"SourceAlpha\" result=\"shadowOffsetOuter1\"></feOffset>\n"
+                           "            <feGaussianBlur stdDeviation=\"0.5\" in=\"shadowOffsetOuter1\" result=\"shadowBlurOuter1\"></feGaussianBlur>\n"
+                           "            <feColorMatrix values=\"0 0 0 0 0   0 0 0 0 0   0 0 0 0 0  0 0 0 0.05 0\" type=\"matrix\" in=\"shadowBlurOuter1\"></feColorMatrix>\n"
+                           "        </filter>\n"));
+    // 日期
+    data.append("        " + dayList.at(date.day() - 1));
+    data.append(QByteArray("        <filter x=\"-84.1%\" y=\"-17.1%\" width=\"268.1%\" height=\"148.0%\" filterUnits=\"objectBoundingBox\" id=\"filter-6\">\n"
+                           "                <feOffset dx=\"0\" dy=\"2\" in=\"SourceAlpha\" result=\"shadowOffsetOuter1\"></feOffset>\n"
+                           "                <feGaussianBlur stdDeviation=\"2\" in=\"shadowOffsetOuter1\" result=\"shadowBlurOuter1\"></feGaussianBlur>\n"
+                           "                <feColorMatrix values=\"0 0 0 0 0.000854821203   0 0 0 0 0.168099661   0 0 0 0 0.309386322  0 0 0 0.2 0\" type=\"matrix\" in=\"shadowBlurOuter1\"></feColorMatrix>\n"
+                           "        </filter>\n"
+                           "    </defs>\n"
+                           "    <g id=\"0101\" stroke=\"none\" stroke-width=\"1\" fill=\"none\" fill-rule=\"evenodd\">\n"
+                           "        <rect id=\"矩形备份-2\" fill=\"#FFFFFF\" transform=\"translate(48.000000, 48.000000) rotate(-8.000000) translate(-48.000000, -48.000000) \" x=\"8\" y=\"8\" width=\"80\" height=\"80\" rx=\"14.625\"></rect>\n"
+                           "        <g id=\"编组\" transform=\"translate(66.782981, 56.296829)\">\n"));
+    // 右下角
+    data.append(QByteArray("        <path d=\"M24.7611755,2.4045457 L24.7620537,12.774523 C24.7620537,20.8516875 18.2142182,27.399523 10.1370537,27.399523 L2.76205369,27.399523 C10.2787204,26.4804054 15.5648315,23.5698662 18.620387,18.6679054 C21.6750819,13.7673254 23.7220114,8.34620554 24.7611755,2.4045457 Z\" id=\"形状结合\" fill-opacity=\"0.39\" fill=\"url(#radialGradient-1)\" transform=\"translate(13.762054, 14.899523) rotate(-8.000000) translate(-13.762054, -14.899523) \"></path>\n"));
+
+    // 背景
+    data.append(QByteArray("            <g id=\"路径-11\" transform=\"translate(13.197333, 14.473976) rotate(-8.000000) translate(-13.197333, -14.473976) \">\n"
+                           "                <use fill=\"black\" fill-opacity=\"1\" filter=\"url(#filter-4)\" xlink:href=\"#path-3\"></use>\n"
+                           "                <use fill=\"url(#linearGradient-2)\" fill-rule=\"evenodd\" xlink:href=\"#path-3\"></use>\n"
+                           "            </g>\n"
+                           "        </g>\n"));
+    // 月份
+    data.append("        " + monthList.at(date.month() - 1));
+    // 日期
+    data.append(QByteArray("        <g id=\"1\" fill-rule=\"nonzero\" transform=\"translate(46.076101, 52.505543) rotate(-8.000000) translate(-46.076101, -52.505543) \">\n"
+                           "            <use fill=\"black\" fill-opacity=\"1\" filter=\"url(#filter-6)\" xlink:href=\"#path-5\"></use>\n"
+                           "            <use fill=\"#2D394F\" xlink:href=\"#path-5\"></use>\n"
+                           "            <use fill=\"#2D394F\" xlink:href=\"#path-5\"></use>\n"
+                           "        </g>\n"));
+    // 星期
+    data.append("        " + weekList.at(date.dayOfWeek() - 1));
+
+    // 右下角
+    data.append(QByteArray("    </g>\n"
+                           "</svg>"));
+
+    return data;
+}
+
+/**
+ * @brief calendarIcon 获取日历应用的图标, 按日期、尺寸及缩放比缓存, 日期变化后重新生成
+ * @param size 图标大小
+ * @param ratio 设备缩放比
+ * @return 日历图标
+ */
+const QPixmap calendarIcon(const int size, const qreal ratio)
+{
+    static QDate cacheDate;
+    static QHash<QPair<int, qreal>, QPixmap> iconCache;
+
+    const QDate currentDate = QDate::currentDate();
+    if (cacheDate != currentDate) {
+        iconCache.clear();
+        cacheDate = currentDate;
     }
 
-    return true;
+    const QPair<int, qreal> key(size, ratio);
+    auto it = iconCache.constFind(key);
+    if (it != iconCache.constEnd())
+        return it.value();
+
+    // 直接在内存中渲染, 不再写入临时文件
+    QSvgRenderer renderer(calendarIconData(currentDate));
+    if (!renderer.isValid())
+        return QPixmap();
+
+    QImage image(QSize(size, size) * ratio, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    renderer.render(&painter, image.rect());
+    painter.end();
+
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(ratio);
+    iconCache.insert(key, pixmap);
+
+    return pixmap;
 }
 
 int perfectIconSize(const int size)
@@ -309,26 +418,19 @@ int perfectIconSize(const int size)
  */
 bool getThemeIcon(QPixmap &pixmap, const ItemInfo_v1 &itemInfo, const int size)
 {
-    QString iconName;
+    const QString iconName = itemInfo.m_iconKey;
     QIcon icon;
     bool findIcon = true;
 
-    if (itemInfo.m_desktop.contains("/dde-calendar.desktop")) {
-        QString name = QStandardPaths::standardLocations(QStandardPaths::TempLocation).first() + "/"
-                +  QString::number(QDate::currentDate().year())
-                + "_" + QString::number(QDate::currentDate().dayOfYear()) + ".svg";
-
-        if (!createCalendarIcon(name))
-            iconName = itemInfo.m_iconKey;
-        else
-            iconName = name;
-    } else {
-        iconName = itemInfo.m_iconKey;
-    }
-
     const qreal ratio = qApp->devicePixelRatio();
     const int iconSize = perfectIconSize(size);
 
+    if (itemInfo.m_desktop.contains("/dde-calendar.desktop")) {
+        pixmap = calendarIcon(iconSize, ratio);
+        if (!pixmap.isNull())
+            return findIcon;
+    }
+
     do {
         if (iconName.isEmpty())
             return findIcon;
@@ -415,15 +517,72 @@ QString cacheKey(const ItemInfo_v1 &itemInfo)
 }
 
 DConfig *ConfigWorker::INSTANCE = Q_NULLPTR;
+QSharedPointer<const ConfigSnapshot> ConfigWorker::SNAPSHOT;
 
 DConfig *ConfigWorker::instance()
 {
-    if (!INSTANCE)
+    if (!INSTANCE) {
         INSTANCE = new DConfig(DLauncher::DEFAULT_META_CONFIG_NAME);
 
+        // 先于其他对象连接, 保证其他对象收到配置变化时快照已经更新
+        QObject::connect(INSTANCE, &DConfig::valueChanged, INSTANCE, [] {
+            refreshSnapshot();
+        });
+    }
+
     return INSTANCE;
 }
 
+/**
+ * @brief ConfigWorker::snapshot 获取当前的配置快照, 持有的快照在配置变化后保持不变
+ * @return 配置快照
+ */
+QSharedPointer<const ConfigSnapshot> ConfigWorker::snapshot()
+{
+    if (SNAPSHOT.isNull())
+        refreshSnapshot();
+
+    return SNAPSHOT;
+}
+
+/**
+ * @brief ConfigWorker::refreshSnapshot 重新读取所有配置生成新的快照, 读取完成后整体替换旧快照
+ */
+void ConfigWorker::refreshSnapshot()
+{
+    QSharedPointer<ConfigSnapshot> snapshot(new ConfigSnapshot);
+
+    if (!instance()->isValid()) {
+        qWarning() << QString("DConfig is invalid, name:[%1], subpath[%2].").
+                        arg(instance()->name(), instance()->subpath());
+        SNAPSHOT = snapshot;
+        return;
+    }
+
+    const QStringList keyList = instance()->keyList();
+    auto value = [ & ](const QString &key, const QVariant &defaultValue) {
+        return keyList.contains(key) ? instance()->value(key) : defaultValue;
+    };
+
+    auto stringSet = [ & ](const QString &key) {
+        QSet<QString> set;
+        const QVariantList list = value(key, QVariantList()).toList();
+        set.reserve(list.size());
+        for (const QVariant &item : list)
+            set.insert(item.toString());
+
+        return set;
+    };
+
+    snapshot->showLingLongSuffix = value(DLauncher::SHOW_LINGLONG_SUFFIX, snapshot->showLingLongSuffix).toBool();
+    snapshot->useSolidBackground = value(DLauncher::USE_SOLID_BACKGROUND, snapshot->useSolidBackground).toBool();
+    snapshot->enableFullScreenMode = value(DLauncher::ENABLE_FULL_SCREEN_MODE, snapshot->enableFullScreenMode).toBool();
+    snapshot->unableToDockApps = stringSet(DLauncher::UNABLE_TO_DOCK_LIST);
+    snapshot->disableScalingApps = stringSet(DLauncher::APPS_DISABLE_SCALING);
+
+    SNAPSHOT = snapshot;
+}
+
 QVariant ConfigWorker::getValue(const QString &key, const QVariant &defaultValue)
 {
     if (!instance()->isValid()) {
@@ -454,4 +613,5 @@ void ConfigWorker::setValue(const QString &key, const QVariant &value)
     }
 
     instance()->setValue(key, value);
+    refreshSnapshot();
 }
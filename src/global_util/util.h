@@ -12,6 +12,7 @@
 
 #include <QtCore>
 #include <QGSettings>
+#include <QColor>
 
 DCORE_USE_NAMESPACE
 
@@ -23,27 +24,45 @@ enum CacheType {
 QString getCategoryNames(QString text);
 const QPixmap loadSvg(const QString &fileName, const int size);
 const QPixmap loadSvg(const QString &fileName, const QSize &size);
-const QPixmap renderSVG(const QString &path, const QSize &size);
+const QPixmap renderSVG(const QString &path, const QSize &size, const QColor &color = QColor());
 QGSettings *SettingsPtr(const QString &schema_id, const QByteArray &path = QByteArray(), QObject *parent = nullptr);
 QGSettings *ModuleSettingsPtr(const QString &module, const QByteArray &path = QByteArray(), QObject *parent = nullptr);
 QString qtify_name(const char *name);
 QVariant SettingValue(const QString &schema_id, const QByteArray &path = QByteArray(), const QString &key = QString(), const QVariant &fallback = QVariant());
-bool createCalendarIcon(const QString &fileName);
+const QPixmap calendarIcon(const int size, const qreal ratio);
 int perfectIconSize(const int size);
 QString cacheKey(const ItemInfo_v1 &itemInfo);
 bool getThemeIcon(QPixmap &pixmap, const ItemInfo_v1 &itemInfo, const int size);
 QIcon getIcon(const QString &name);
 
+/**
+ * @brief The ConfigSnapshot struct 启动器配置的快照
+ * 绘制及逐项查询的代码通过快照读取配置, 不直接访问 DConfig, 配置变化时整体替换快照
+ */
+struct ConfigSnapshot
+{
+    bool showLingLongSuffix = false;            // 显示玲珑应用后缀
+    bool useSolidBackground = false;            // 全屏模式使用纯色背景
+    bool enableFullScreenMode = true;           // 是否支持切换到全屏模式
+    QSet<QString> unableToDockApps;             // 不可拖拽到任务栏驻留的应用
+    QSet<QString> disableScalingApps;           // 禁用缩放的应用
+};
+
 class ConfigWorker : QObject
 {
     Q_OBJECT
 public:
     static DConfig *instance();
+    static QSharedPointer<const ConfigSnapshot> snapshot();
 
     static QVariant getValue(const QString &key, const QVariant &defaultValue = QVariant());
     static void setValue(const QString &key, const QVariant &value = QVariant());
 
+private:
+    static void refreshSnapshot();
+
 private:
     static DConfig *INSTANCE;
+    static QSharedPointer<const ConfigSnapshot> SNAPSHOT;
 };
 #endif // UTIL_H
@@ -12,6 +12,7 @@
 #include "amdbuslauncherinterface.h"
 #include "amdbusdockinterface.h"
 #include "aminterface.h"
+#include "timescheduler.h"
 
 #define SessionManagerService "org.deepin.dde.SessionManager1"
 #define SessionManagerPath "/org/deepin/dde/SessionManager1"
@@ -171,6 +172,9 @@ void LauncherSys::displayModeChanged()
 
 void LauncherSys::onVisibleChanged()
 {
+    // 启动器隐藏时暂停日期定时, 避免后台周期性唤醒
+    TimeScheduler::instance()->setLauncherVisible(m_launcherInter->visible());
+
     emit visibleChanged(m_launcherInter->visible());
 }
 
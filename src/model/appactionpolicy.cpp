@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appactionpolicy.h"
+#include "util.h"
+
+#include <DSysInfo>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QGSettings>
+#include <QSettings>
+#include <QStandardPaths>
+
+DCORE_USE_NAMESPACE
+
+static const QString ChainsProxy_path = QStandardPaths::standardLocations(QStandardPaths::ConfigLocation).first()
+        + "/deepin/proxychains.conf";
+
+/**
+ * @brief The PackageListKey struct 应用列表配置项与对应的策略
+ */
+struct PackageListKey
+{
+    const char *key;                    // QGSettings::changed 信号中的键名
+    const char *name;                   // gschema 中的键名
+    AppActionPolicy::Policy policy;
+};
+
+static const PackageListKey PackageListKeys[] = {
+    { "appsHideOpenList",               "apps-hide-open-list",                  AppActionPolicy::HideOpen },
+    { "appsHideSendToDesktopList",      "apps-hide-send-to-desktop-list",       AppActionPolicy::HideSendToDesktop },
+    { "appsHideSendToDockList",         "apps-hide-send-to-dock-list",          AppActionPolicy::HideSendToDock },
+    { "appsHideStartUpList",            "apps-hide-start-up-list",              AppActionPolicy::HideStartUp },
+    { "appsHideUninstallList",          "apps-hide-uninstall-list",             AppActionPolicy::HideUninstall },
+    { "appsHideUseProxyList",           "apps-hide-use-proxy-list",             AppActionPolicy::HideUseProxy },
+    { "appsCanNotOpenList",             "apps-can-not-open-list",               AppActionPolicy::CantOpen },
+    { "appsCanNotSendToDesktopList",    "apps-can-not-send-to-desktop-list",    AppActionPolicy::CantSendToDesktop },
+    { "appsCanNotSendToDockList",       "apps-can-not-send-to-dock-list",       AppActionPolicy::CantSendToDock },
+    { "appsCanNotStartUpList",          "apps-can-not-start-up-list",           AppActionPolicy::CantStartUp },
+    { "appsCanNotUseProxyList",         "apps-can-not-use-proxy-list",          AppActionPolicy::CantUseProxy },
+    { "appsHoldList",                   "apps-hold-list",                       AppActionPolicy::CantUninstall },
+};
+
+/**
+ * @brief The ActionKey struct 菜单配置中的功能项开关与关闭时对应的策略
+ */
+struct ActionKey
+{
+    const char *name;
+    AppActionPolicy::Policy policy;
+};
+
+static const ActionKey ActionKeys[] = {
+    { "open",               AppActionPolicy::HideOpen },
+    { "send-to-desktop",    AppActionPolicy::HideSendToDesktop },
+    { "send-to-dock",       AppActionPolicy::HideSendToDock },
+    { "auto-start",         AppActionPolicy::HideStartUp },
+    { "uninstall",          AppActionPolicy::HideUninstall },
+    { "use-proxy",          AppActionPolicy::HideUseProxy },
+};
+
+QPointer<AppActionPolicy> AppActionPolicy::INSTANCE = nullptr;
+
+AppActionPolicy *AppActionPolicy::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new AppActionPolicy(nullptr);
+
+    return INSTANCE;
+}
+
+AppActionPolicy::AppActionPolicy(QObject *parent)
+    : QObject(parent)
+    , m_launcherSettings(SettingsPtr("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", this))
+    , m_actionSettings(SettingsPtr("com.deepin.dde.launcher.menu", "/com/deepin/dde/launcher/menu/", this))
+    , m_proxyConfigWatcher(nullptr)
+    , m_globalPolicies(NoPolicy)
+{
+    if (!DSysInfo::isCommunityEdition()) {
+        m_proxyConfigWatcher = new QFileSystemWatcher(this);
+        watchProxyConfig();
+
+        auto onProxyConfigChanged = [ this ] {
+            watchProxyConfig();
+            compileGlobalPolicies();
+        };
+        connect(m_proxyConfigWatcher, &QFileSystemWatcher::fileChanged, this, onProxyConfigChanged);
+        connect(m_proxyConfigWatcher, &QFileSystemWatcher::directoryChanged, this, onProxyConfigChanged);
+    }
+
+    if (m_launcherSettings)
+        connect(m_launcherSettings, &QGSettings::changed, this, &AppActionPolicy::onLauncherSettingsChanged);
+
+    if (m_actionSettings)
+        connect(m_actionSettings, &QGSettings::changed, this, &AppActionPolicy::compileGlobalPolicies);
+
+    compile();
+}
+
+/**
+ * @brief AppActionPolicy::policies 获取应用的策略
+ * @param appKey 应用 key
+ * @return 对所有应用生效的策略与应用自身策略的组合
+ */
+AppActionPolicy::Policies AppActionPolicy::policies(const QString &appKey) const
+{
+    return m_globalPolicies | m_appPolicies.value(appKey, NoPolicy);
+}
+
+bool AppActionPolicy::testPolicy(const QString &appKey, Policy policy) const
+{
+    return policies(appKey).testFlag(policy);
+}
+
+/**
+ * @brief AppActionPolicy::compile 根据配置重新编译所有应用的策略
+ */
+void AppActionPolicy::compile()
+{
+    m_appPolicies.clear();
+
+    for (const PackageListKey &listKey : PackageListKeys)
+        addPackages(packages(listKey.key, listKey.name), listKey.policy);
+
+    //从/etc/deepin-installer.conf读取不可卸载软件列表
+    const QSettings settings("/etc/deepin-installer.conf", QSettings::IniFormat);
+    addPackages(settings.value("dde_launcher_hold_packages").toStringList(), CantUninstall);
+
+    compileGlobalPolicies();
+}
+
+/**
+ * @brief AppActionPolicy::compileGlobalPolicies 根据菜单功能项开关及代理配置文件编译对所有应用生效的策略
+ */
+void AppActionPolicy::compileGlobalPolicies()
+{
+    Policies globalPolicies = NoPolicy;
+
+    if (m_actionSettings) {
+        for (const ActionKey &actionKey : ActionKeys) {
+            if (!m_actionSettings->get(actionKey.name).toBool())
+                globalPolicies |= actionKey.policy;
+        }
+    }
+
+    // 专业版等版本没有代理配置文件时不显示使用代理
+    if (!DSysInfo::isCommunityEdition() && !QFile::exists(ChainsProxy_path))
+        globalPolicies |= HideUseProxy;
+
+    m_globalPolicies = globalPolicies;
+}
+
+void AppActionPolicy::addPackages(const QStringList &packages, Policy policy)
+{
+    for (const QString &package : packages)
+        m_appPolicies[package] |= policy;
+}
+
+/**
+ * @brief AppActionPolicy::watchProxyConfig 监听代理配置文件及其所在目录, 文件创建或删除后重新添加监听,
+ * 目录不存在时监听最近的上级目录, 目录创建后再改为监听目录本身
+ */
+void AppActionPolicy::watchProxyConfig()
+{
+    if (!m_proxyConfigWatcher)
+        return;
+
+    QString dirPath = QFileInfo(ChainsProxy_path).absolutePath();
+    while (!QFileInfo::exists(dirPath) && dirPath != QDir::rootPath())
+        dirPath = QFileInfo(dirPath).absolutePath();
+
+    for (const QString &path : m_proxyConfigWatcher->directories()) {
+        if (path != dirPath)
+            m_proxyConfigWatcher->removePath(path);
+    }
+
+    const QStringList watchedPaths = m_proxyConfigWatcher->files() + m_proxyConfigWatcher->directories();
+    for (const QString &path : { dirPath, ChainsProxy_path }) {
+        if (!watchedPaths.contains(path) && QFile::exists(path))
+            m_proxyConfigWatcher->addPath(path);
+    }
+}
+
+/**
+ * @brief AppActionPolicy::packages 从gschema读取应用列表
+ * @param key 应用列表的键名
+ * @param name 应用列表在 gschema 中的键名
+ * @return 应用列表, 配置不存在时返回空列表
+ */
+QStringList AppActionPolicy::packages(const QString &key, const QString &name) const
+{
+    if (!m_launcherSettings || !m_launcherSettings->keys().contains(key))
+        return QStringList();
+
+    return m_launcherSettings->get(name).toStringList();
+}
+
+void AppActionPolicy::onLauncherSettingsChanged(const QString &key)
+{
+    for (const PackageListKey &listKey : PackageListKeys) {
+        if (key == QLatin1String(listKey.key)) {
+            compile();
+            return;
+        }
+    }
+}
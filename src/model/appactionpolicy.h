@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPACTIONPOLICY_H
+#define APPACTIONPOLICY_H
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QStringList>
+
+class QGSettings;
+class QFileSystemWatcher;
+
+/**
+ * @brief The AppActionPolicy class 应用右键菜单功能项的策略
+ * 将菜单配置及各应用隐藏、禁用列表编译为每个应用的一组标志位, 配置变化时重新编译,
+ * 查询时只需一次哈希查找和位运算
+ */
+class AppActionPolicy : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Policy {
+        NoPolicy            = 0,
+        HideOpen            = 1 << 0,       // 隐藏打开
+        HideSendToDesktop   = 1 << 1,       // 隐藏发送到桌面
+        HideSendToDock      = 1 << 2,       // 隐藏发送到任务栏
+        HideStartUp         = 1 << 3,       // 隐藏开机自动启动
+        HideUninstall       = 1 << 4,       // 隐藏卸载
+        HideUseProxy        = 1 << 5,       // 隐藏使用代理
+        CantOpen            = 1 << 6,       // 不可打开
+        CantSendToDesktop   = 1 << 7,       // 不可发送到桌面
+        CantSendToDock      = 1 << 8,       // 不可发送到任务栏
+        CantStartUp         = 1 << 9,       // 不可开机自动启动
+        CantUseProxy        = 1 << 10,      // 不可使用代理
+        CantUninstall       = 1 << 11,      // 不可卸载
+    };
+    Q_DECLARE_FLAGS(Policies, Policy)
+
+    static AppActionPolicy *instance();
+
+    Policies policies(const QString &appKey) const;
+    bool testPolicy(const QString &appKey, Policy policy) const;
+
+private:
+    explicit AppActionPolicy(QObject *parent = nullptr);
+
+    void compile();
+    void compileGlobalPolicies();
+    void addPackages(const QStringList &packages, Policy policy);
+    void watchProxyConfig();
+    QStringList packages(const QString &key, const QString &name) const;
+
+private slots:
+    void onLauncherSettingsChanged(const QString &key);
+
+private:
+    static QPointer<AppActionPolicy> INSTANCE;
+
+    QGSettings *m_launcherSettings;                 // 各功能项隐藏、禁用的应用列表
+    QGSettings *m_actionSettings;                   // 菜单功能项开关
+    QFileSystemWatcher *m_proxyConfigWatcher;       // 监听代理配置文件及所在目录, 文件不存在时隐藏使用代理
+
+    Policies m_globalPolicies;                      // 对所有应用生效的策略
+    QHash<QString, Policies> m_appPolicies;         // 应用 key 与应用自身的策略
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(AppActionPolicy::Policies)
+
+#endif // APPACTIONPOLICY_H
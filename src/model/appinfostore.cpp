@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appinfostore.h"
+
+#include <QSet>
+
+const AppId AppInfoStore::InvalidId;
+
+AppInfoStore::AppInfoStore()
+    : m_nextId(InvalidId + 1)
+{
+}
+
+/**
+ * @brief AppInfoStore::recordKey 记录的键值, 应用使用 desktop 路径,
+ * 没有 desktop 路径的分类标题使用分类 id
+ * @param info 应用信息
+ * @return 记录的键值
+ */
+QString AppInfoStore::recordKey(const ItemInfo_v1 &info)
+{
+    if (info.m_desktop.isEmpty())
+        return QString("category_%1").arg(info.m_categoryId);
+
+    return info.m_desktop;
+}
+
+/**
+ * @brief AppInfoStore::insert 添加记录, 记录已存在时更新该记录
+ * @param info 应用信息
+ * @return 记录的 id
+ */
+AppId AppInfoStore::insert(const ItemInfo_v1 &info)
+{
+    const QString key = recordKey(info);
+    const AppId id = m_recordIds.value(key, InvalidId);
+    if (id != InvalidId) {
+        m_records[id].updateInfo(info);
+        return id;
+    }
+
+    const AppId newId = m_nextId++;
+    m_records.insert(newId, info);
+    m_recordIds.insert(key, newId);
+
+    return newId;
+}
+
+/**
+ * @brief AppInfoStore::insert 添加记录, 新记录直接转移 info 中的数据
+ * @param info 应用信息
+ * @return 记录的 id
+ */
+AppId AppInfoStore::insert(ItemInfo_v1 &&info)
+{
+    const QString key = recordKey(info);
+    const AppId id = m_recordIds.value(key, InvalidId);
+    if (id != InvalidId) {
+        m_records[id].updateInfo(info);
+        return id;
+    }
+
+    const AppId newId = m_nextId++;
+    m_records[newId] = std::move(info);
+    m_recordIds.insert(key, newId);
+
+    return newId;
+}
+
+/**
+ * @brief AppInfoStore::find 根据键值查找记录
+ * @param key 记录的键值, 应用为 desktop 路径
+ * @return 记录的 id, 不存在时返回 InvalidId
+ */
+AppId AppInfoStore::find(const QString &key) const
+{
+    return m_recordIds.value(key, InvalidId);
+}
+
+bool AppInfoStore::contains(AppId id) const
+{
+    return m_records.contains(id);
+}
+
+/**
+ * @brief AppInfoStore::info 获取记录的应用信息
+ * @param id 记录的 id
+ * @return 应用信息, 记录不存在时返回空的应用信息
+ */
+const ItemInfo_v1 &AppInfoStore::info(AppId id) const
+{
+    static const ItemInfo_v1 emptyInfo;
+
+    auto it = m_records.constFind(id);
+    if (it == m_records.constEnd())
+        return emptyInfo;
+
+    return it.value();
+}
+
+/**
+ * @brief AppInfoStore::record 获取可修改的记录, 不可修改记录的键值(desktop 路径)
+ * @param id 记录的 id
+ * @return 记录的指针, 不存在时返回空指针
+ */
+ItemInfo_v1 *AppInfoStore::record(AppId id)
+{
+    auto it = m_records.find(id);
+    if (it == m_records.end())
+        return nullptr;
+
+    return &it.value();
+}
+
+void AppInfoStore::remove(AppId id)
+{
+    auto it = m_records.find(id);
+    if (it == m_records.end())
+        return;
+
+    m_recordIds.remove(recordKey(it.value()));
+    m_records.erase(it);
+}
+
+/**
+ * @brief AppInfoStore::retain 只保留给定 id 对应的记录
+ * @param ids 需要保留的记录 id 列表
+ */
+void AppInfoStore::retain(const AppIdList &ids)
+{
+    QSet<AppId> idSet;
+    idSet.reserve(ids.size());
+    for (const AppId id : ids)
+        idSet.insert(id);
+
+    for (auto it = m_records.begin(); it != m_records.end();) {
+        if (idSet.contains(it.key())) {
+            ++it;
+            continue;
+        }
+
+        m_recordIds.remove(recordKey(it.value()));
+        it = m_records.erase(it);
+    }
+}
+
+/**
+ * @brief AppInfoStore::infoList 将 id 列表转换为应用信息列表
+ * @param ids 记录 id 列表
+ * @return 应用信息列表, 忽略已不存在的记录
+ */
+ItemInfoList_v1 AppInfoStore::infoList(const AppIdList &ids) const
+{
+    ItemInfoList_v1 list;
+    list.reserve(ids.size());
+    for (const AppId id : ids) {
+        auto it = m_records.constFind(id);
+        if (it != m_records.constEnd())
+            list.append(it.value());
+    }
+
+    return list;
+}
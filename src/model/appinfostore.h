@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPINFOSTORE_H
+#define APPINFOSTORE_H
+
+#include "iteminfo.h"
+
+#include <QHash>
+#include <QVector>
+
+typedef quint32 AppId;
+typedef QVector<AppId> AppIdList;
+
+/**
+ * @brief The AppInfoStore class 应用信息记录表
+ * 每个应用(或分类标题)只保存一份记录, 各排序列表中只保存记录的 id,
+ * 应用信息更新时只需修改对应的一条记录
+ */
+class AppInfoStore
+{
+public:
+    static const AppId InvalidId = 0;
+
+    AppInfoStore();
+
+    static QString recordKey(const ItemInfo_v1 &info);
+
+    AppId insert(const ItemInfo_v1 &info);
+    AppId insert(ItemInfo_v1 &&info);
+    AppId find(const QString &key) const;
+    bool contains(AppId id) const;
+
+    const ItemInfo_v1 &info(AppId id) const;
+    ItemInfo_v1 *record(AppId id);
+
+    void remove(AppId id);
+    void retain(const AppIdList &ids);
+
+    ItemInfoList_v1 infoList(const AppIdList &ids) const;
+    int size() const { return m_records.size(); }
+
+private:
+    QHash<AppId, ItemInfo_v1> m_records;        // 记录 id 与应用信息
+    QHash<QString, AppId> m_recordIds;          // 记录键值(desktop 路径)与记录 id
+    AppId m_nextId;                             // 下一条记录的 id, 已删除的 id 不再复用
+};
+
+#endif // APPINFOSTORE_H
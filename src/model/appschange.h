@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPSCHANGE_H
+#define APPSCHANGE_H
+
+#include <QVector>
+
+/**
+ * @brief The AppsChange struct 应用列表的一次变化
+ * AppsManager 修改列表前后分别发出 itemsAboutToChange 及 itemsChanged 信号,
+ * 模型据此发出对应的行插入、移除、移动或数据变化信号, 不再重置整个列表
+ */
+struct AppsChange
+{
+    enum Type {
+        Insert,                 // 插入元素
+        Remove,                 // 移除元素
+        Move,                   // 移动元素
+        Update,                 // 元素数据变化, 列表结构不变
+    };
+
+    Type type;
+    int first;                  // 变化的第一个元素在列表中的位置
+    int last;                   // 变化的最后一个元素在列表中的位置
+    int destination;            // 移动时元素移动到该位置之前, 为移动前列表中的位置
+    QVector<int> roles;         // 数据变化的角色, 为空时表示所有角色
+
+    static AppsChange inserted(int first, int last)
+    {
+        return AppsChange { Insert, first, last, -1, QVector<int>() };
+    }
+
+    static AppsChange removed(int first, int last)
+    {
+        return AppsChange { Remove, first, last, -1, QVector<int>() };
+    }
+
+    static AppsChange moved(int row, int destination)
+    {
+        return AppsChange { Move, row, row, destination, QVector<int>() };
+    }
+
+    static AppsChange updated(int first, int last, const QVector<int> &roles = QVector<int>())
+    {
+        return AppsChange { Update, first, last, -1, roles };
+    }
+};
+
+#endif // APPSCHANGE_H
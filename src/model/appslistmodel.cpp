@@ -4,6 +4,7 @@
 
 #include "appslistmodel.h"
 #include "appsmanager.h"
+#include "appactionpolicy.h"
 #include "calculate_util.h"
 #include "constants.h"
 #include "dbusvariant/iteminfo.h"
@@ -12,8 +13,6 @@
 #include <QSize>
 #include <QDebug>
 #include <QPixmap>
-#include <QSettings>
-#include <QGSettings>
 #include <QVariant>
 
 #include <DHiDPIHelper>
@@ -23,9 +22,6 @@
 DWIDGET_USE_NAMESPACE
 DGUI_USE_NAMESPACE
 
-static QString ChainsProxy_path = QStandardPaths::standardLocations(QStandardPaths::ConfigLocation).first()
-        + "/deepin/proxychains.conf";
-
 static QMap<int, AppsListModel::AppCategory> CateGoryMap {
     { 0,  AppsListModel::Internet    },
     { 1,  AppsListModel::Chat        },
@@ -40,179 +36,25 @@ static QMap<int, AppsListModel::AppCategory> CateGoryMap {
     { 10, AppsListModel::Others      }
 };
 
-const QStringList sysHideUseProxyPackages();
-const QStringList sysCantUseProxyPackages();
-
-static QGSettings *gSetting = SettingsPtr("com.deepin.dde.launcher", "/com/deepin/dde/launcher/");
-static QStringList hideUseProxyPackages(sysHideUseProxyPackages());
-static QStringList cantUseProxyPackages(sysCantUseProxyPackages());
-
-const QStringList sysHideOpenPackages()
-{
-    QStringList hideOpen_list;
-    //从gschema读取隐藏打开功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideOpenList")) {
-        hideOpen_list << gSetting->get("apps-hide-open-list").toStringList();
-    }
-
-    return hideOpen_list;
-}
-
-const QStringList sysHideSendToDesktopPackages()
-{
-    QStringList hideSendToDesktop_list;
-    //从gschema读取隐藏发送到桌面功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideSendToDesktopList")) {
-        hideSendToDesktop_list << gSetting->get("apps-hide-send-to-desktop-list").toStringList();
-    }
-
-    return hideSendToDesktop_list;
-}
-
-const QStringList sysHideSendToDockPackages()
-{
-    QStringList hideSendToDock_list;
-    //从gschema读取隐藏发送到Ｄock功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideSendToDockList")) {
-        hideSendToDock_list << gSetting->get("apps-hide-send-to-dock-list").toStringList();
-    }
-
-    return hideSendToDock_list;
-}
-
-const QStringList sysHideStartUpPackages()
-{
-    QStringList hideStartUp_list;
-    //从gschema读取隐藏开机启动功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideStartUpList")) {
-        hideStartUp_list << gSetting->get("apps-hide-start-up-list").toStringList();
-    }
-
-    return hideStartUp_list;
-}
-
-const QStringList sysHideUninstallPackages()
-{
-    QStringList hideUninstall_list;
-    //从gschema读取隐藏开机启动功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideUninstallList")) {
-        hideUninstall_list << gSetting->get("apps-hide-uninstall-list").toStringList();
-    }
-
-    return hideUninstall_list;
-}
-
-const QStringList sysHideUseProxyPackages()
-{
-    QStringList hideUseProxy_list;
-    //从gschema读取隐藏使用代理功能软件列表
-    if (gSetting && gSetting->keys().contains("appsHideUseProxyList")) {
-        hideUseProxy_list << gSetting->get("apps-hide-use-proxy-list").toStringList();
-    }
-
-    QObject::connect(gSetting, &QGSettings::changed, [ & ](const QString &key) {
-        if (!key.compare("appsHideUseProxyList"))
-            hideUseProxyPackages = sysHideUseProxyPackages();
-    });
-
-    return hideUseProxy_list;
-}
-
-const QStringList sysCantUseProxyPackages()
-{
-    QStringList cantUseProxy_list;
-    //从gschema读取隐藏使用代理功能软件列表
-    if (gSetting && gSetting->keys().contains("appsCanNotUseProxyList")) {
-        cantUseProxy_list << gSetting->get("apps-can-not-use-proxy-list").toStringList();
-    }
-
-    QObject::connect(gSetting, &QGSettings::changed, [ & ](const QString &key) {
-        if (!key.compare("appsCanNotUseProxyList"))
-            cantUseProxyPackages = sysCantUseProxyPackages();
-    });
-
-    return cantUseProxy_list;
-}
-
-const QStringList sysCantOpenPackages()
-{
-    QStringList cantOpen_list;
-    //从gschema读取不可打开软件列表
-    if (gSetting && gSetting->keys().contains("appsCanNotOpenList")) {
-        cantOpen_list << gSetting->get("apps-can-not-open-list").toStringList();
-    }
-
-    return cantOpen_list;
-}
-
-const QStringList sysCantSendToDesktopPackages()
-{
-    QStringList cantSendToDesktop_list;
-    //从gschema读取不可发送到桌面软件列表
-    if (gSetting && gSetting->keys().contains("appsCanNotSendToDesktopList")) {
-        cantSendToDesktop_list << gSetting->get("apps-can-not-send-to-desktop-list").toStringList();
-    }
-
-    return cantSendToDesktop_list;
-}
-
-const QStringList sysCantSendToDockPackages()
-{
-    QStringList cantSendToDock_list;
-    //从gschema读取不可发送到Dock软件列表
-    if (gSetting && gSetting->keys().contains("appsCanNotSendToDockList")) {
-        cantSendToDock_list << gSetting->get("apps-can-not-send-to-dock-list").toStringList();
-    }
-
-    return cantSendToDock_list;
-}
-
-const QStringList sysCantStartUpPackages()
-{
-    QStringList cantStartUp_list;
-    //从gschema读取不可自动启动软件列表
-    if (gSetting &&gSetting->keys().contains("appsCanNotStartUpList")) {
-        cantStartUp_list << gSetting->get("apps-can-not-start-up-list").toStringList();
-    }
-
-    return cantStartUp_list;
-}
-
-const QStringList sysHoldPackages()
-{
-    //从先/etc/deepin-installer.conf读取不可卸载软件列表
-    const QSettings settings("/etc/deepin-installer.conf", QSettings::IniFormat);
-    auto holds_list = settings.value("dde_launcher_hold_packages").toStringList();
-
-    //再从gschema读取不可卸载软件列表
-    if (gSetting && gSetting->keys().contains("appsHoldList")) {
-        holds_list << gSetting->get("apps-hold-list").toStringList();
-    }
-
-    return holds_list;
-}
-
 AppsListModel::AppsListModel(const AppCategory &category, QObject *parent)
     : QAbstractListModel(parent)
     , m_appsManager(AppsManager::instance())
-    , m_actionSettings(SettingsPtr("com.deepin.dde.launcher.menu", "/com/deepin/dde/launcher/menu/", this))
+    , m_actionPolicy(AppActionPolicy::instance())
     , m_calcUtil(CalculateUtil::instance())
-    , m_hideOpenPackages(sysHideOpenPackages())
-    , m_hideSendToDesktopPackages(sysHideSendToDesktopPackages())
-    , m_hideSendToDockPackages(sysHideSendToDockPackages())
-    , m_hideStartUpPackages(sysHideStartUpPackages())
-    , m_hideUninstallPackages(sysHideUninstallPackages())
-    , m_cantOpenPackages(sysCantOpenPackages())
-    , m_cantSendToDesktopPackages(sysCantSendToDesktopPackages())
-    , m_cantSendToDockPackages(sysCantSendToDockPackages())
-    , m_cantStartUpPackages(sysCantStartUpPackages())
-    , m_holdPackages(sysHoldPackages())
     , m_category(category)
     , m_drawBackground(true)
     , m_pageIndex(0)
+    , m_changePending(false)
+    , m_pendingChangeType(AppsChange::Update)
 {
     connect(m_appsManager, &AppsManager::dataChanged, this, &AppsListModel::dataChanged);
+    connect(m_appsManager, &AppsManager::itemsAboutToChange, this, &AppsListModel::itemsAboutToChange);
+    connect(m_appsManager, &AppsManager::itemsChanged, this, &AppsListModel::itemsChanged);
     connect(m_appsManager, &AppsManager::itemDataChanged, this, &AppsListModel::itemDataChanged);
+    connect(m_appsManager, &AppsManager::iconsChanged, this, [ this ] {
+        if (rowCount() > 0)
+            emit QAbstractItemModel::dataChanged(index(0), index(rowCount() - 1));
+    });
 }
 
 void AppsListModel::setCategory(const AppsListModel::AppCategory category)
@@ -222,6 +64,20 @@ void AppsListModel::setCategory(const AppsListModel::AppCategory category)
     emit QAbstractListModel::layoutChanged();
 }
 
+/**
+ * @brief AppsListModel::setPageIndex 设置模型对应的分页, 分页视图复用时模型数据整体变化
+ * @param pageIndex 分页索引
+ */
+void AppsListModel::setPageIndex(int pageIndex)
+{
+    if (m_pageIndex == pageIndex)
+        return;
+
+    beginResetModel();
+    m_pageIndex = pageIndex;
+    endResetModel();
+}
+
 /**
  * @brief AppsListModel::setDraggingIndex 保存当前拖动的item对应的模型索引
  * @param index 拖动的item对应的模型索引
@@ -293,9 +149,14 @@ void AppsListModel::dropSwap(const int nextPos)
     const ItemInfo_v1 &appInfo = m_dragStartIndex.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
 
     // 从文件夹展开窗口移除应用时，文件夹本身不执行移动操作
+    // 优先在列表内直接移动, 不支持移动的列表仍然先移除再插入
     if (m_appsManager->getDragMode() != AppsManager::DirOut) {
-        removeRows(m_dragStartIndex.row(), 1, QModelIndex());
-        dropInsert(appInfo.m_desktop, nextPos);
+        const int dragRow = m_dragStartIndex.row();
+        const int destinationChild = (nextPos > dragRow) ? (nextPos + 1) : nextPos;
+        if (nextPos != dragRow && !moveRow(QModelIndex(), dragRow, QModelIndex(), destinationChild)) {
+            removeRows(dragRow, 1, QModelIndex());
+            dropInsert(appInfo.m_desktop, nextPos);
+        }
     }
 
     emit QAbstractItemModel::dataChanged(m_dragStartIndex, m_dragDropIndex);
@@ -343,6 +204,49 @@ int AppsListModel::rowCount(const QModelIndex &parent) const
     return qMin(pageCount, nPageCount);
 }
 
+/**
+ * @brief AppsListModel::moveRows 在当前页面内移动1个item, 只通知视图移动的行, 不重置整个列表
+ * @param sourceParent 父节点模型索引
+ * @param sourceRow 被移动的item所在的行
+ * @param count 移动的item个数
+ * @param destinationParent 目标父节点模型索引
+ * @param destinationChild 移动前的目标行, item 移动到该行之前
+ * @return 返回移动状态标识
+ */
+bool AppsListModel::moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild)
+{
+    if (count != 1 || sourceParent.isValid() || destinationParent.isValid())
+        return false;
+
+    if ((m_category != AppsListModel::FullscreenAll) && (m_category != AppsListModel::Dir)
+            && (m_category != AppsListModel::Favorite))
+        return false;
+
+    // 向后移动时, item 最终位于目标行的前一行
+    const int targetRow = (destinationChild > sourceRow) ? (destinationChild - 1) : destinationChild;
+    const int rows = rowCount();
+    if (sourceRow < 0 || sourceRow >= rows || targetRow < 0 || targetRow >= rows)
+        return false;
+
+    int pageOffset = 0;
+    if ((m_category == AppsListModel::FullscreenAll) || (m_category == AppsListModel::Dir))
+        pageOffset = m_pageIndex * m_calcUtil->appPageItemCount(m_category);
+
+    // 先确认能够移动再通知视图, 失败时不发出任何信号
+    const int from = pageOffset + sourceRow;
+    const int to = pageOffset + targetRow;
+    if (!m_appsManager->canMoveItem(m_category, from, to))
+        return false;
+
+    if (!beginMoveRows(sourceParent, sourceRow, sourceRow, destinationParent, destinationChild))
+        return false;
+
+    m_appsManager->moveItem(m_category, from, to);
+    endMoveRows();
+
+    return true;
+}
+
 /**
  * @brief AppsListModel::indexAt 根据appkey值返回app所在的模型索引
  * @param appKey app key
@@ -368,7 +272,7 @@ void AppsListModel::setDrawBackground(bool draw)
 
     m_drawBackground = draw;
 
-    emit QAbstractItemModel::dataChanged(QModelIndex(), QModelIndex());
+    emitDataChanged();
 }
 
 void AppsListModel::updateModelData(const QModelIndex dragIndex, const QModelIndex dropIndex)
@@ -457,7 +361,7 @@ QMimeData *AppsListModel::mimeData(const QModelIndexList &indexes) const
     // 拖动应用到任务栏驻留针对不同应用提供配置功能, 默认为启用
     const QString &appKey = index.data(AppKeyRole).toString();
 
-    if (!ConfigWorker::getValue(DLauncher::UNABLE_TO_DOCK_LIST, QStringList()).toStringList().contains(appKey))
+    if (!ConfigWorker::snapshot()->unableToDockApps.contains(appKey))
         mime->setData("RequestDock", index.data(AppDesktopRole).toByteArray());
 
     mime->setData("DesktopPath", index.data(AppDesktopRole).toByteArray());
@@ -482,8 +386,15 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     int nFixCount = m_calcUtil->appPageItemCount(m_category);
     int pageCount = qMin(nFixCount, nSize - nFixCount * m_pageIndex);
 
-    if(!m_calcUtil->fullscreen()) {
+    // 先检查行号, 无效的索引不再获取应用信息
+    const bool paged = m_calcUtil->fullscreen() && (m_category != Search) && (m_category != PluginSearch);
+    if (!paged)
         pageCount = nSize;
+
+    if (!index.isValid() || index.row() >= pageCount)
+        return QVariant();
+
+    if(!m_calcUtil->fullscreen()) {
         if (m_category == TitleMode)
             itemInfo = m_appsManager->appsCategoryListIndex(index.row());
         else if (m_category == LetterMode) {
@@ -498,7 +409,6 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     } else {
         if ((m_category == Search) || (m_category == PluginSearch)) {
             // 保证搜索原数据模型中的数据未经过翻页处理
-            pageCount = nSize;
             itemInfo = m_appsManager->appsInfoListIndex(m_category, index.row());
         } else {
             int start = nFixCount * m_pageIndex;
@@ -506,10 +416,48 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
         }
     }
 
-    if (!index.isValid() || index.row() >= pageCount)
-        return QVariant();
-
     switch (role) {
+    case AppTileInfoRole: {
+        // 绘制应用项时一次获取所有数据, 避免重复查找应用信息
+        AppTileInfo tileInfo;
+        tileInfo.iconSize = m_calcUtil->appIconSize(m_category);
+        tileInfo.displayName = m_appsManager->appDisplayName(itemInfo);
+        tileInfo.fontPixelSize = DFontSizeManager::instance()->fontPixelSize(DFontSizeManager::T6);
+        tileInfo.isDir = itemInfo.m_isDir;
+        tileInfo.isTitle = itemInfo.m_iconKey.isEmpty();
+        tileInfo.isDragging = indexDragging(index);
+        tileInfo.drawBackground = m_drawBackground;
+        tileInfo.newInstall = m_appsManager->appIsNewInstall(itemInfo.m_key);
+        tileInfo.autoStart = !itemInfo.m_isDir && m_appsManager->appIsAutoStart(itemInfo.m_desktop);
+        tileInfo.info = std::move(itemInfo);
+        return QVariant::fromValue(tileInfo);
+    }
+    case AppMenuInfoRole: {
+        AppMenuInfo menuInfo;
+        menuInfo.key = itemInfo.m_key;
+        menuInfo.desktop = itemInfo.m_desktop;
+        menuInfo.isOnDesktop = m_appsManager->appIsOnDesktop(itemInfo.m_key);
+        menuInfo.isOnDock = m_appsManager->appIsOnDock(itemInfo.m_desktop);
+        menuInfo.autoStart = m_appsManager->appIsAutoStart(itemInfo.m_desktop);
+        menuInfo.isProxy = m_appsManager->appIsProxy(itemInfo.m_key);
+        menuInfo.enableScaling = m_appsManager->appIsEnableScaling(itemInfo.m_key);
+        menuInfo.isInFavorite = m_appsManager->appIsFavorite(itemInfo.m_desktop);
+
+        const AppActionPolicy::Policies policies = m_actionPolicy->policies(itemInfo.m_key);
+        menuInfo.isRemovable = !policies.testFlag(AppActionPolicy::CantUninstall);
+        menuInfo.hideOpen = policies.testFlag(AppActionPolicy::HideOpen);
+        menuInfo.hideSendToDesktop = policies.testFlag(AppActionPolicy::HideSendToDesktop);
+        menuInfo.hideSendToDock = policies.testFlag(AppActionPolicy::HideSendToDock);
+        menuInfo.hideStartUp = policies.testFlag(AppActionPolicy::HideStartUp);
+        menuInfo.hideUninstall = policies.testFlag(AppActionPolicy::HideUninstall);
+        menuInfo.hideUseProxy = policies.testFlag(AppActionPolicy::HideUseProxy);
+        menuInfo.canOpen = !policies.testFlag(AppActionPolicy::CantOpen);
+        menuInfo.canSendToDesktop = !policies.testFlag(AppActionPolicy::CantSendToDesktop);
+        menuInfo.canSendToDock = !policies.testFlag(AppActionPolicy::CantSendToDock);
+        menuInfo.canStartUp = !policies.testFlag(AppActionPolicy::CantStartUp);
+        menuInfo.canUseProxy = !policies.testFlag(AppActionPolicy::CantUseProxy);
+        return QVariant::fromValue(menuInfo);
+    }
     case AppRawItemInfoRole:
         return QVariant::fromValue(itemInfo);
     case AppNameRole:
@@ -527,7 +475,7 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     case AppIsOnDockRole:
         return m_appsManager->appIsOnDock(itemInfo.m_desktop);
     case AppIsRemovableRole:
-        return !m_holdPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantUninstall);
     case AppIsProxyRole:
         return m_appsManager->appIsProxy(itemInfo.m_key);
     case AppEnableScalingRole:
@@ -555,35 +503,38 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     case DrawBackgroundRole:
         return m_drawBackground;
     case AppHideOpenRole:
-        return (m_actionSettings && !m_actionSettings->get("open").toBool()) || m_hideOpenPackages.contains(itemInfo.m_key);
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideOpen);
     case AppHideSendToDesktopRole:
-        return (m_actionSettings && !m_actionSettings->get("send-to-desktop").toBool()) || m_hideSendToDesktopPackages.contains(itemInfo.m_key);
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideSendToDesktop);
     case AppHideSendToDockRole:
-        return (m_actionSettings && !m_actionSettings->get("send-to-dock").toBool()) || m_hideSendToDockPackages.contains(itemInfo.m_key);
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideSendToDock);
     case AppHideStartUpRole:
-        return (m_actionSettings && !m_actionSettings->get("auto-start").toBool()) || m_hideStartUpPackages.contains(itemInfo.m_key);
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideStartUp);
     case AppHideUninstallRole:
-        return (m_actionSettings && !m_actionSettings->get("uninstall").toBool()) || m_hideUninstallPackages.contains(itemInfo.m_key);
-    case AppHideUseProxyRole: {
-        bool hideUse = ((m_actionSettings && !m_actionSettings->get("use-proxy").toBool()) || hideUseProxyPackages.contains(itemInfo.m_key));
-        return DSysInfo::isCommunityEdition() ? hideUse : (!QFile::exists(ChainsProxy_path) || hideUse);
-    }
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideUninstall);
+    case AppHideUseProxyRole:
+        return m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::HideUseProxy);
     case AppCanOpenRole:
-        return !m_cantOpenPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantOpen);
     case AppCanSendToDesktopRole:
-        return !m_cantSendToDesktopPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantSendToDesktop);
     case AppCanSendToDockRole:
-        return !m_cantSendToDockPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantSendToDock);
     case AppCanStartUpRole:
-        return !m_cantStartUpPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantStartUp);
     case AppCanOpenProxyRole:
-        return !cantUseProxyPackages.contains(itemInfo.m_key);
+        return !m_actionPolicy->testPolicy(itemInfo.m_key, AppActionPolicy::CantUseProxy);
     case ItemIsDirRole:
         return itemInfo.m_isDir;
     case DirItemInfoRole:
         return QVariant::fromValue(itemInfo.m_appInfoList);
     case DirAppIconsRole: {
-        QList<QPixmap> pixmapList = m_appsManager->getDirAppIcon(index);
+        // 文件夹缩略图中最多显示4个应用
+        QList<QPixmap> pixmapList;
+        const int iconSize = m_calcUtil->appIconSize(m_category).width();
+        for (int i = 0; itemInfo.m_isDir && i < qMin(4, itemInfo.m_appInfoList.size()); i++)
+            pixmapList << m_appsManager->appIcon(itemInfo.m_appInfoList.at(i), iconSize);
+
         return QVariant::fromValue(pixmapList);
     }
     case AppItemTitleRole:
@@ -594,10 +545,8 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     }
     case AppItemStatusRole:
         return itemInfo.m_status;
-    case AppIsInFavoriteRole: {
-        const ItemInfoList_v1 list = m_appsManager->appsInfoList(AppsListModel::Favorite);
-        return list.contains(itemInfo);
-    }
+    case AppIsInFavoriteRole:
+        return m_appsManager->appIsFavorite(itemInfo.m_desktop);
     default:
         break;
     }
@@ -638,7 +587,154 @@ void AppsListModel::dataChanged(const AppCategory category)
 void AppsListModel::layoutChanged(const AppsListModel::AppCategory category)
 {
     if (category == FullscreenAll || category == m_category)
-        emit QAbstractItemModel::dataChanged(QModelIndex(), QModelIndex());
+        emitDataChanged();
+}
+
+/**
+ * @brief AppsListModel::isPaged 全屏时除收藏及搜索列表外, 模型只对应列表中的一页
+ * @return 模型是否分页
+ */
+bool AppsListModel::isPaged() const
+{
+    if (!m_calcUtil->fullscreen())
+        return false;
+
+    return (m_category != AppsListModel::Favorite) && (m_category != AppsListModel::Search)
+            && (m_category != AppsListModel::PluginSearch);
+}
+
+/**
+ * @brief AppsListModel::followsCategory 本地搜索模型显示的是小窗口所有应用列表, 同样需要处理该列表的变化
+ * @param category 发生变化的列表类型
+ * @return 模型是否需要处理该列表的变化
+ */
+bool AppsListModel::followsCategory(const AppsListModel::AppCategory category) const
+{
+    return (category == m_category) || (m_category == AppsListModel::Search && category == AppsListModel::WindowedAll);
+}
+
+/**
+ * @brief AppsListModel::itemsAboutToChange 列表修改前发出对应的行变化开始信号
+ * 分页模型中当前页之前的变化会使本页的内容整体平移, 此时只通知本页行数的变化,
+ * 平移的内容在 itemsChanged 中作为数据变化通知
+ * @param category 发生变化的列表类型
+ * @param change 列表的变化
+ */
+void AppsListModel::itemsAboutToChange(const AppsListModel::AppCategory category, const AppsChange &change)
+{
+    if (!followsCategory(category) || change.type == AppsChange::Update)
+        return;
+
+    if (!isPaged()) {
+        switch (change.type) {
+        case AppsChange::Insert:
+            beginInsertRows(QModelIndex(), change.first, change.last);
+            break;
+        case AppsChange::Remove:
+            beginRemoveRows(QModelIndex(), change.first, change.last);
+            break;
+        case AppsChange::Move:
+            // 移动到原位置时没有变化, 不需要结束信号
+            if (!beginMoveRows(QModelIndex(), change.first, change.last, QModelIndex(), change.destination))
+                return;
+            break;
+        default:
+            return;
+        }
+
+        m_changePending = true;
+        m_pendingChangeType = change.type;
+        return;
+    }
+
+    const int pageCount = m_calcUtil->appPageItemCount(m_category);
+    const int pageStart = m_pageIndex * pageCount;
+    int sizeDelta = 0;
+    if (change.type == AppsChange::Insert)
+        sizeDelta = change.last - change.first + 1;
+    else if (change.type == AppsChange::Remove)
+        sizeDelta = change.first - change.last - 1;
+
+    // 变化在当前页之后时本页不受影响
+    if (sizeDelta == 0 || change.first >= pageStart + pageCount)
+        return;
+
+    const int oldCount = rowCount();
+    const int newCount = qBound(0, m_appsManager->appsInfoListSize(m_category) + sizeDelta - pageStart, pageCount);
+    if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+        m_pendingChangeType = AppsChange::Insert;
+    } else if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+        m_pendingChangeType = AppsChange::Remove;
+    } else {
+        return;
+    }
+
+    m_changePending = true;
+}
+
+/**
+ * @brief AppsListModel::itemsChanged 列表修改后发出对应的行变化结束信号, 并只通知内容发生变化的行
+ * @param category 发生变化的列表类型
+ * @param change 列表的变化
+ */
+void AppsListModel::itemsChanged(const AppsListModel::AppCategory category, const AppsChange &change)
+{
+    if (!followsCategory(category))
+        return;
+
+    if (m_changePending) {
+        m_changePending = false;
+        switch (m_pendingChangeType) {
+        case AppsChange::Insert:
+            endInsertRows();
+            break;
+        case AppsChange::Remove:
+            endRemoveRows();
+            break;
+        case AppsChange::Move:
+            endMoveRows();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 不分页时行变化信号已经准确描述了结构变化, 只需处理数据变化
+    int first = change.first;
+    int last = change.last;
+    int pageStart = 0;
+    if (isPaged()) {
+        pageStart = m_pageIndex * m_calcUtil->appPageItemCount(m_category);
+        if (change.type == AppsChange::Insert || change.type == AppsChange::Remove) {
+            last = pageStart + rowCount() - 1;
+        } else if (change.type == AppsChange::Move) {
+            first = qMin(change.first, change.destination);
+            last = qMax(change.last, change.destination - 1);
+        }
+    } else if (change.type != AppsChange::Update) {
+        return;
+    }
+
+    const int firstRow = qMax(first - pageStart, 0);
+    const int lastRow = qMin(last - pageStart, rowCount() - 1);
+    if (firstRow > lastRow)
+        return;
+
+    emit QAbstractItemModel::dataChanged(index(firstRow), index(lastRow), change.roles);
+}
+
+/**
+ * @brief AppsListModel::emitDataChanged 通知视图所有行的数据变化, 使用确切的行范围而不是无效索引
+ */
+void AppsListModel::emitDataChanged()
+{
+    const int count = rowCount();
+    if (count <= 0)
+        return;
+
+    emit QAbstractItemModel::dataChanged(index(0), index(count - 1));
 }
 
 /**
@@ -660,19 +756,23 @@ bool AppsListModel::indexDragging(const QModelIndex &index) const
 }
 
 /**
- * @brief AppsListModel::itemDataChanged item数据变化时触发模型内部信号
+ * @brief AppsListModel::itemDataChanged item数据变化时触发模型内部信号, 包含该应用的文件夹缩略图也一并重绘
  * @param info 数据发生变化的item信息
  */
 void AppsListModel::itemDataChanged(const ItemInfo_v1 &info)
 {
-    int i = 0;
+    // 全屏非搜索列表按页显示, 列表位置需要换算为当前页的行号
+    int pageOffset = 0;
+    if (m_calcUtil->fullscreen() && (m_category != Search) && (m_category != PluginSearch))
+        pageOffset = m_calcUtil->appPageItemCount(m_category) * m_pageIndex;
+
     const int count = rowCount();
-    while (i != count) {
-        if (index(i).data(AppKeyRole).toString() == info.m_key) {
-            const QModelIndex modelIndex = index(i);
-            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
-            return;
-        }
-        ++i;
+    for (const int listIndex : m_appsManager->itemIndexes(m_category, info)) {
+        const int row = listIndex - pageOffset;
+        if (row < 0 || row >= count)
+            continue;
+
+        const QModelIndex modelIndex = index(row);
+        emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
     }
 }
@@ -5,9 +5,14 @@
 #ifndef APPSLISTMODEL_H
 #define APPSLISTMODEL_H
 
+#include "appschange.h"
+#include "iteminfo.h"
+
 #include <QAbstractListModel>
+#include <QSize>
 #define MAXIMUM_POPULAR_ITEMS 11
 
+class AppActionPolicy;
 class AppsManager;
 class CalculateUtil;
 class ItemInfo_v1;
@@ -61,6 +66,8 @@ public:
         AppCanSendToDockRole,
         AppCanStartUpRole,
         AppCanOpenProxyRole,
+        AppTileInfoRole,
+        AppMenuInfoRole,
     };
 
     enum AppCategory {
@@ -89,7 +96,7 @@ public:
 
 public:
     explicit AppsListModel(const AppCategory& category, QObject *parent = nullptr);
-    void setPageIndex(int pageIndex) { m_pageIndex = pageIndex; }
+    void setPageIndex(int pageIndex);
     int getPageIndex() const { return m_pageIndex; }
 
     inline AppCategory category() const {return m_category;}
@@ -102,6 +109,7 @@ public:
     inline QModelIndex dragDropIndex() const {return m_dragDropIndex;}
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    bool moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild) Q_DECL_OVERRIDE;
     const QModelIndex indexAt(const QString &appKey) const;
 
     void setDrawBackground(bool draw);
@@ -122,38 +130,79 @@ protected:
 private:
     void dataChanged(const AppsListModel::AppCategory category);
     void layoutChanged(const AppsListModel::AppCategory category);
+    void itemsAboutToChange(const AppsListModel::AppCategory category, const AppsChange &change);
+    void itemsChanged(const AppsListModel::AppCategory category, const AppsChange &change);
+    bool isPaged() const;
+    bool followsCategory(const AppsListModel::AppCategory category) const;
     bool indexDragging(const QModelIndex &index) const;
     void itemDataChanged(const ItemInfo_v1 &info);
+    void emitDataChanged();
 
 private:
     AppsManager *m_appsManager;
-    QGSettings *m_actionSettings;
+    AppActionPolicy *m_actionPolicy;
     CalculateUtil *m_calcUtil;
 
     QList<ItemInfo_v1> m_itemList;
 
-    QStringList m_hideOpenPackages;
-    QStringList m_hideSendToDesktopPackages;
-    QStringList m_hideSendToDockPackages;
-    QStringList m_hideStartUpPackages;
-    QStringList m_hideUninstallPackages;
-
-    QStringList m_cantOpenPackages;
-    QStringList m_cantSendToDesktopPackages;
-    QStringList m_cantSendToDockPackages;
-    QStringList m_cantStartUpPackages;
-    QStringList m_cantUseProxyPackages;
-    QStringList m_holdPackages;
-
     QModelIndex m_dragStartIndex = QModelIndex();
     QModelIndex m_dragDropIndex = QModelIndex();
     AppCategory m_category;
 
     bool m_drawBackground;
     int m_pageIndex;
+
+    bool m_changePending;                       // 已发出 begin* 信号, 等待列表修改完成
+    AppsChange::Type m_pendingChangeType;       // 已发出的 begin* 信号对应的变化类型
 };
 typedef QList<AppsListModel *> PageAppsModelist;
 
+/**
+ * @brief The AppTileInfo struct 绘制应用项所需的数据, 通过 AppTileInfoRole 一次获取
+ */
+struct AppTileInfo
+{
+    ItemInfo_v1 info;                   // 应用信息
+    QString displayName;                // 显示的应用名称, 未省略
+    QSize iconSize;                     // 图标大小
+    int fontPixelSize = 0;              // 应用名称字体大小
+    bool isDir = false;                 // 是否为应用文件夹
+    bool isTitle = false;               // 是否为分类标题
+    bool isDragging = false;            // 是否正在拖拽
+    bool drawBackground = false;        // 是否绘制背景
+    bool newInstall = false;            // 是否为新安装的应用
+    bool autoStart = false;             // 是否为自启动应用, 应用文件夹始终为 false
+};
+
+/**
+ * @brief The AppMenuInfo struct 创建应用右键菜单所需的数据, 通过 AppMenuInfoRole 一次获取
+ */
+struct AppMenuInfo
+{
+    QString key;                        // 应用 key
+    QString desktop;                    // 应用 desktop 路径
+    bool isOnDesktop = false;           // 是否已发送到桌面
+    bool isOnDock = false;              // 是否已驻留任务栏
+    bool autoStart = false;             // 是否为自启动应用
+    bool isProxy = false;               // 是否使用代理
+    bool enableScaling = false;         // 是否启用缩放
+    bool isInFavorite = false;          // 是否在收藏列表中
+    bool isRemovable = false;           // 是否可卸载
+    bool hideOpen = false;              // 隐藏打开
+    bool hideSendToDesktop = false;     // 隐藏发送到桌面
+    bool hideSendToDock = false;        // 隐藏发送到任务栏
+    bool hideStartUp = false;           // 隐藏开机启动
+    bool hideUninstall = false;         // 隐藏卸载
+    bool hideUseProxy = false;          // 隐藏使用代理
+    bool canOpen = false;               // 可以打开
+    bool canSendToDesktop = false;      // 可以发送到桌面
+    bool canSendToDock = false;         // 可以发送到任务栏
+    bool canStartUp = false;            // 可以设置开机启动
+    bool canUseProxy = false;           // 可以使用代理
+};
+
 Q_DECLARE_METATYPE(AppsListModel::AppCategory)
+Q_DECLARE_METATYPE(AppTileInfo)
+Q_DECLARE_METATYPE(AppMenuInfo)
 
 #endif // APPSLISTMODEL_H
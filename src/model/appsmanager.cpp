@@ -7,6 +7,8 @@
 #include "constants.h"
 #include "calculate_util.h"
 #include "aminterface.h"
+#include "timescheduler.h"
+#include "stringpool.h"
 
 #include <QDebug>
 #include <QX11Info>
@@ -21,13 +23,31 @@
 #include <QStandardPaths>
 #include <QByteArrayList>
 #include <QQueue>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <QCache>
 
 #include <DHiDPIHelper>
+#include <DPlatformTheme>
 #include <DApplication>
 #include "dpinyin.h"
 
 #define AUTOSTART_KEY "autostart-desktop-list"
 
+// 已找到的应用图标缓存上限(字节)
+static const int MAX_APP_ICON_CACHE_COST = 32 * 1024 * 1024;
+
+/**
+ * @brief appIconCache 已找到的应用图标缓存, 键值包含图标主题及图标名称,
+ * 图标主题或图标目录变化时清空, 应用更新时移除该应用的图标
+ */
+static QCache<QString, QPixmap> &appIconCache()
+{
+    static QCache<QString, QPixmap> cache(MAX_APP_ICON_CACHE_COST);
+    return cache;
+}
+
 DWIDGET_USE_NAMESPACE
 DWIDGET_USE_NAMESPACE
 
@@ -37,7 +57,6 @@ QGSettings *AppsManager::m_launcherSettings = SettingsPtr("com.deepin.dde.launch
 QSet<QString> AppsManager::APP_AUTOSTART_CACHE;
 QSettings AppsManager::APP_USED_SORTED_LIST("deepin", "dde-launcher-app-used-sorted-list");
 QSettings AppsManager::APP_CATEGORY_USED_SORTED_LIST("deepin","dde-launcher-app-category-used-sorted-list");
-static constexpr int USER_SORT_UNIT_TIME = 3600; // 1 hours
 
 bool AppsManager::readJsonFile(QIODevice &device, QSettings::SettingsMap &map)
 {
@@ -69,17 +88,13 @@ AppsManager::AppsManager(QObject *parent)
     , m_amDbusDockInter(new AMDBusDockInter(this))
     , m_calUtil(CalculateUtil::instance())
     , m_delayRefreshTimer(new QTimer(this))
-    , m_refreshCalendarIconTimer(new QTimer(this))
-    , m_lastShowDate(0)
-    , m_tryNums(0)
-    , m_tryCount(0)
-    , m_itemInfo(ItemInfo_v1())
+    , m_iconDirWatcher(new QFileSystemWatcher(this))
+    , m_refreshIconTimer(new QTimer(this))
     , m_autostartDesktopListSetting(new QSettings("deepin", AUTOSTART_KEY, this))
     , m_filterSetting(nullptr)
     , m_iconValid(true)
     , m_trashIsEmpty(false)
     , m_trashMonitor(new TrashMonitor(this))
-    , m_updateCalendarTimer(new QTimer(this))
     , m_uninstallDlgIsShown(false)
     , m_dragMode(Other)
     , m_curCategory(AppsListModel::FullscreenAll)
@@ -111,17 +126,15 @@ AppsManager::AppsManager(QObject *parent)
     m_categoryTs.append(tr("System"));
     m_categoryTs.append(tr("Other"));
 
-    m_updateCalendarTimer->setInterval(1000);// 1s
-    m_updateCalendarTimer->start();
-
     updateTrashState();
     refreshAllList();
 
     m_delayRefreshTimer->setSingleShot(true);
     m_delayRefreshTimer->setInterval(500);
 
-    m_refreshCalendarIconTimer->setInterval(1000);
-    m_refreshCalendarIconTimer->setSingleShot(false);
+    // 安装应用时会连续写入多个图标文件, 合并目录变化后统一刷新
+    m_refreshIconTimer->setSingleShot(true);
+    m_refreshIconTimer->setInterval(500);
 
     if (AMInter::isAMReborn()) {
         connect(AMInter::instance(), &AMInter::newAppLaunched, this, &AppsManager::markLaunched);
@@ -145,97 +158,113 @@ AppsManager::AppsManager(QObject *parent)
     }
     connect(m_delayRefreshTimer, &QTimer::timeout, this, &AppsManager::delayRefreshData);
     connect(m_trashMonitor, &TrashMonitor::trashAttributeChanged, this, &AppsManager::updateTrashState, Qt::QueuedConnection);
-    connect(m_refreshCalendarIconTimer, &QTimer::timeout, this, &AppsManager::onRefreshCalendarTimer);
-
-    if (!m_refreshCalendarIconTimer->isActive())
-        m_refreshCalendarIconTimer->start();
+    // 日期变化后刷新日历图标及新安装应用状态
+    connect(TimeScheduler::instance(), &TimeScheduler::dateChanged, this, &AppsManager::delayRefreshData);
+    connect(m_iconDirWatcher, &QFileSystemWatcher::directoryChanged, this, &AppsManager::onIconDirectoryChanged);
+    connect(m_refreshIconTimer, &QTimer::timeout, this, &AppsManager::refreshIcon);
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, &AppsManager::clearIconCache);
 }
 
 void AppsManager::showSearchedData(const AppInfoList &list)
 {
-    m_appSearchResultList = ItemInfo_v1::appListToItemV1List(list);
+    // 搜索结果均为已记录的应用, 只保存记录 id
+    const ItemInfoList_v1 searchResult = ItemInfo_v1::appListToItemV1List(list);
+    m_appSearchResultList.clear();
+    m_appSearchResultList.reserve(searchResult.size());
+    for (const ItemInfo_v1 &info : searchResult) {
+        const AppId id = m_appStore.find(info.m_desktop);
+        if (id != AppInfoStore::InvalidId)
+            m_appSearchResultList.append(id);
+    }
 }
 
-ItemInfoList_v1 AppsManager::sortByLetterOrder(ItemInfoList_v1 &list)
+/**
+ * @brief pinyinSortKey 应用名称的拼音排序键值
+ * @param name 应用名称
+ * @return 去掉数字(表示拼音中的声调)后的拼音字符串
+ */
+static QString pinyinSortKey(const QString &name)
 {
-    // 字母标题生成器
-    static QList<QChar> alphabetList;
-    if (alphabetList.isEmpty()) {
-        alphabetList.append('#');
-        for (int i = 0; i < 26; i++)
-            alphabetList.append(QChar('A' + i));
+    const QString pinyin = Chinese2Pinyin(name);
+
+    QString key;
+    key.reserve(pinyin.size());
+    for (const QChar &ch : pinyin) {
+        if (!ch.isDigit())
+            key.append(ch);
     }
 
-    ItemInfoList_v1 letterGroupList;
-    // 按照字母表顺序对应用进行分组排序
-    for (int i = 0; i < alphabetList.size(); i++) {
-        const QChar &titleChar = alphabetList[i];
-        ItemInfo_v1 titleInfo;
-        titleInfo.m_name = titleChar;
-        titleInfo.m_desktop = titleChar;
-
-        ItemInfoList_v1 groupList;
-        for (int j = 0; j < list.size(); j++) {
-            const ItemInfo_v1 &info = list.at(j);
-            // 去掉字符串中的数字(表示拼音中的声调)
-            const QString pinYinStr = Chinese2Pinyin(info.m_name).remove(QRegExp("\\d"));
-            if (info.startWithNum()) {
-                if (!contains(groupList, titleInfo) && (!contains(letterGroupList, titleInfo)))
-                    groupList.append(titleInfo);
-
-                if (!contains(letterGroupList, info))
-                    groupList.append(info);
-            } else if (pinYinStr.startsWith(titleChar, Qt::CaseInsensitive)) {
-                if (!contains(groupList, titleInfo))
-                    groupList.append(titleInfo);
-
-                if (!contains(letterGroupList, info))
-                    groupList.append(info);
-            }
+    return key;
+}
 
-            if (j == list.size() - 1) {
-                // 数字不变, 在首字母相同的且都为中文的分组中比较全拼音，按升序排列
-                sortByPinyinOrder(groupList);
-            }
+/**
+ * @brief AppsManager::sortByLetterOrder 按照字母表顺序对应用进行分组排序
+ * 每个应用只计算一次排序键值, 一次遍历即可将应用放入对应的字母分组
+ * @param list 按照通用规则排序后的应用列表
+ * @return 带有字母标题的分组列表, 数字开头的应用归入 '#' 分组
+ */
+ItemInfoList_v1 AppsManager::sortByLetterOrder(ItemInfoList_v1 &list)
+{
+    // 分组 0 为数字开头的应用, 分组 1-26 对应字母 A-Z
+    static const int letterGroupCount = 27;
+
+    struct CollationKey {
+        int index;                      // 应用在 list 中的位置
+        bool startWithLetter;           // 应用名称是否以字母开头
+        QString pinyin;                 // 拼音排序键值
+    };
+
+    QVector<QVector<CollationKey>> groups(letterGroupCount);
+    for (int i = 0; i < list.size(); i++) {
+        const ItemInfo_v1 &info = list.at(i);
+        CollationKey key { i, info.startWithLetter(), pinyinSortKey(info.m_name) };
+
+        int group = -1;
+        if (info.startWithNum()) {
+            group = 0;
+        } else if (!key.pinyin.isEmpty()) {
+            const QChar firstChar = key.pinyin.at(0).toUpper();
+            if (firstChar >= QLatin1Char('A') && firstChar <= QLatin1Char('Z'))
+                group = firstChar.unicode() - 'A' + 1;
         }
 
-        // 该字母分类下没有应用时，不加入到列表
-        if (groupList.size() > 1)
-            letterGroupList.append(groupList);
+        // 拼音不以字母开头的应用不属于任何分组
+        if (group != -1)
+            groups[group].append(std::move(key));
     }
 
-    return letterGroupList;
-}
+    ItemInfoList_v1 letterGroupList;
+    letterGroupList.reserve(list.size() + letterGroupCount);
+    for (int group = 0; group < letterGroupCount; group++) {
+        QVector<CollationKey> &keys = groups[group];
 
-void AppsManager::sortByPinyinOrder(ItemInfoList_v1 &processList)
-{
-    std::sort(processList.begin(), processList.end(), [ & ](ItemInfo_v1 &info1, ItemInfo_v1 &info2) {
-        QString appPinyinName1 = Chinese2Pinyin(info1.m_name).remove(QRegExp("\\d"));
-        QString appPinyinName2 = Chinese2Pinyin(info2.m_name).remove(QRegExp("\\d"));
+        // 该字母分类下没有应用时，不加入到列表
+        if (keys.isEmpty())
+            continue;
 
-        // 1. 若是标题则不执行交换位置;二者中只有一个以字母或者数字开头，保持从小到大的顺序, 维持通用排序的顺序不变
-        // 2. 二者中的其他情况则进行比对, 如果不是从小到大顺序排列，则交换位置
+        // 以字母开头的应用排在中文应用前面, 同类应用比较全拼音按升序排列, 相同时维持通用排序的顺序不变
+        std::stable_sort(keys.begin(), keys.end(), [](const CollationKey &key1, const CollationKey &key2) {
+            if (key1.startWithLetter != key2.startWithLetter)
+                return key1.startWithLetter;
 
-        if (info1.isTitle() || info2.isTitle()
-                || (info1.startWithLetter() && !info2.startWithLetter())
-                || (!info1.startWithLetter() && info2.startWithLetter()))
-            return false;
+            return (key1.pinyin.compare(key2.pinyin, Qt::CaseSensitive) < 0);
+        });
 
-        return (appPinyinName1.compare(appPinyinName2, Qt::CaseSensitive) < 0);
-    });
+        ItemInfo_v1 titleInfo;
+        titleInfo.m_name = (group == 0) ? QChar('#') : QChar('A' + group - 1);
+        titleInfo.m_desktop = titleInfo.m_name;
+        letterGroupList.append(titleInfo);
+
+        for (const CollationKey &key : keys)
+            letterGroupList.append(list.at(key.index));
+    }
+
+    return letterGroupList;
 }
 
 const ItemInfo_v1 AppsManager::getItemInfo(const QString &desktop)
 {
-    ItemInfo_v1 itemInfo;
-    for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            itemInfo = info;
-            break;
-        }
-    }
-
-    return itemInfo;
+    return m_appStore.info(m_appStore.find(desktop));
 }
 
 void AppsManager::dropToCollected(const ItemInfo_v1 &info, const int row)
@@ -289,10 +318,10 @@ QSettings::SettingsMap AppsManager::getCacheMapData(const ItemInfoList_v1 &list)
 const ItemInfoList_v1 AppsManager::readCacheData(const QSettings::SettingsMap &map)
 {
     auto getMapData = [ & ](ItemInfo_v1 &info, const QMap<QString, QVariant> &infoMap) {
-        info.m_desktop = infoMap.value("desktop").toString();
+        info.m_desktop = StringPool::intern(infoMap.value("desktop").toString());
         info.m_name = infoMap.value("appName").toString();
-        info.m_key = infoMap.value("appKey").toString();
-        info.m_iconKey = infoMap.value("iconKey").toString();
+        info.m_key = StringPool::intern(infoMap.value("appKey").toString());
+        info.m_iconKey = StringPool::intern(infoMap.value("iconKey").toString());
         info.m_status = infoMap.value("appStatus").toInt();
         info.m_categoryId = infoMap.value("categoryId").toLongLong();
         info.m_description = infoMap.value("description").toString();
@@ -381,7 +410,7 @@ int AppsManager::getDirAppPageIndex() const
  * @brief AppsManager::sortByPresetOrder app应用按照schemas文件中的预装应用列表顺序进行排序
  * @param processList 系统所有应用软件的信息
  */
-void AppsManager::sortByPresetOrder(ItemInfoList_v1 &processList)
+void AppsManager::sortByPresetOrder(AppIdList &processList)
 {
     const QString system_lang = QLocale::system().name();
 
@@ -402,9 +431,22 @@ void AppsManager::sortByPresetOrder(ItemInfoList_v1 &processList)
     if (m_launcherSettings && preset.isEmpty())
         preset = m_launcherSettings->get("apps-order").toStringList();
 
-    std::sort(processList.begin(), processList.end(), [&preset](const ItemInfo_v1 & i1, const ItemInfo_v1 & i2) {
-        int index1 = preset.indexOf(i1.m_key);
-        int index2 = preset.indexOf(i2.m_key);
+    // 预先计算每个应用在预装列表中的位置, 排序时只比较整数
+    QHash<QString, int> presetIndexes;
+    presetIndexes.reserve(preset.size());
+    for (int i = preset.size() - 1; i >= 0; --i)
+        presetIndexes.insert(preset.at(i), i);
+
+    QHash<AppId, int> appIndexes;
+    appIndexes.reserve(processList.size());
+    for (const AppId id : processList)
+        appIndexes.insert(id, presetIndexes.value(m_appStore.info(id).m_key, -1));
+
+    std::sort(processList.begin(), processList.end(), [ & ](const AppId id1, const AppId id2) {
+        const ItemInfo_v1 &i1 = m_appStore.info(id1);
+        const ItemInfo_v1 &i2 = m_appStore.info(id2);
+        int index1 = appIndexes.value(id1);
+        int index2 = appIndexes.value(id2);
 
         if (index1 == index2) {
             // If both of them don't exist in the preset list,
@@ -427,41 +469,55 @@ void AppsManager::sortByPresetOrder(ItemInfoList_v1 &processList)
 }
 
 /**按照以下优先级对应用进行排序
- * 1. 新装应用排列首部
- * 2. 单位时间内应用的打开次数的大小进行排序
+ * 1. 新装应用排列首部, 按照安装时间由近到远排列
+ * 2. 启动过的应用按照使用频率排名排列, 排名随应用启动实时更新, 此处只需按排名放置
+ * 3. 未启动过的应用维持原有顺序
  * @brief AppsManager::sortByUseFrequence
  * @param processList
  */
-void AppsManager::sortByUseFrequence(ItemInfoList_v1 &processList)
-{
-    const qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
-    std::sort(processList.begin(), processList.end(), [ = ](const ItemInfo_v1 &itemInfo1, const ItemInfo_v1 &itemInfo2) {
-        const bool itemANewInstall = m_newInstalledAppsList.contains(itemInfo1.m_key);
-        const bool itemBNewInstall = m_newInstalledAppsList.contains(itemInfo2.m_key);
-        if (itemANewInstall || itemBNewInstall) {
-            if(itemANewInstall && itemBNewInstall)
-                return (itemInfo1.m_installedTime > itemInfo2.m_installedTime);
-
-            if(itemANewInstall)
-                return true;
-
-            if(itemBNewInstall)
-                return false;
+void AppsManager::sortByUseFrequence(AppIdList &processList)
+{
+    const QStringList rankedApps = m_frecencyRanker.topApps(-1);
+    QHash<QString, int> rankIndexes;
+    rankIndexes.reserve(rankedApps.size());
+    for (int i = 0; i < rankedApps.size(); i++)
+        rankIndexes.insert(rankedApps.at(i), i);
+
+    QVector<int> newInstalledItems;
+    QVector<int> rankedItems(rankedApps.size(), -1);
+    QVector<int> unusedItems;
+    for (int i = 0; i < processList.size(); i++) {
+        const ItemInfo_v1 &info = m_appStore.info(processList.at(i));
+        if (m_newInstalledApps.contains(info.m_key)) {
+            newInstalledItems.append(i);
+            continue;
         }
 
-        const qint64 itemAFirstRunTime = itemInfo1.m_firstRunTime;
-        const qint64 itemBFirstRunTime = itemInfo2.m_firstRunTime;
+        const int rank = rankIndexes.value(info.m_desktop, -1);
+        if (rank != -1 && rankedItems.at(rank) == -1)
+            rankedItems[rank] = i;
+        else
+            unusedItems.append(i);
+    }
+
+    std::stable_sort(newInstalledItems.begin(), newInstalledItems.end(), [ & ](int index1, int index2) {
+        return m_appStore.info(processList.at(index1)).m_installedTime > m_appStore.info(processList.at(index2)).m_installedTime;
+    });
 
-        // If it's past time, will be sorted by open count
-        if ((itemAFirstRunTime > currentTime) || (itemBFirstRunTime > currentTime))
-            return itemInfo1.m_openCount > itemInfo2.m_openCount;
+    AppIdList sortedList;
+    sortedList.reserve(processList.size());
+    for (const int index : newInstalledItems)
+        sortedList.append(processList.at(index));
 
-        qint64 itemAHoursDiff = (currentTime - itemAFirstRunTime) / USER_SORT_UNIT_TIME + 1;
-        qint64 itemBHoursDiff = (currentTime - itemBFirstRunTime) / USER_SORT_UNIT_TIME + 1;
+    for (const int index : rankedItems) {
+        if (index != -1)
+            sortedList.append(processList.at(index));
+    }
 
-        // Average number of starts
-        return ((static_cast<double>(itemInfo1.m_openCount) / itemAHoursDiff) > (static_cast<double>(itemInfo2.m_openCount) / itemBHoursDiff));
-    });
+    for (const int index : unusedItems)
+        sortedList.append(processList.at(index));
+
+    processList = std::move(sortedList);
 }
 
 void AppsManager::loadDefaultFavoriteList(const ItemInfoList_v1 &processList)
@@ -555,32 +611,69 @@ void AppsManager::removeDuplicateData(ItemInfoList_v1 &processList)
 
     // id2Item 只会记录 XDG_DATA_DIRS 中找到的首个 item
     // 这里从列表中移除所有 id2Item 不包含的 item
+    const ItemInfoList_v1 keptItems = id2Item.values();
     auto it = std::remove_if(processList.begin(), processList.end(), [&](const ItemInfo_v1 &item){
-        return !id2Item.values().contains(item);
+        return !keptItems.contains(item);
     });
 
     if (it != processList.end())
         processList.erase(it);
 }
 
-void AppsManager::removeNonexistentData()
+/**
+ * @brief AppsManager::installedAppId 查找与给定应用信息一致的已安装应用记录
+ * @param item 应用信息
+ * @return 记录的 id, 应用未安装或信息不一致时返回 AppInfoStore::InvalidId
+ */
+AppId AppsManager::installedAppId(const ItemInfo_v1 &item) const
 {
-    // 移除 m_appInfos 中已经不存在的应用
-    QHash<AppsListModel::AppCategory, ItemInfoList_v1>::iterator categoryAppsIter = m_appInfos.begin();
-    for (; categoryAppsIter != m_appInfos.end(); ++categoryAppsIter) {
-        ItemInfoList_v1 &item = categoryAppsIter.value();
-        for (auto it(item.begin()); it != item.end();) {
-            if (!contains(m_allAppInfoList, *it)) {
-                it = item.erase(it);
-            } else {
-                // 多语言时，更新应用信息
-                int index = itemIndex(m_allAppInfoList, *it);
-                if (index != -1)
-                    it->updateInfo(m_allAppInfoList[index]);
+    const AppId id = m_appStore.find(item.m_desktop);
+    if (id == AppInfoStore::InvalidId || !m_appStore.info(id).isSimilar(item))
+        return AppInfoStore::InvalidId;
 
-                ++it;
-            }
+    return id;
+}
+
+/**
+ * @brief AppsManager::installedAppIds 将缓存的应用列表转换为记录 id 列表
+ * 忽略未安装及重复的应用, 记录中没有打开次数时使用缓存中的打开次数
+ * @param cachedList 缓存的应用列表
+ * @return 记录 id 列表
+ */
+AppIdList AppsManager::installedAppIds(const ItemInfoList_v1 &cachedList)
+{
+    AppIdList ids;
+    ids.reserve(cachedList.size());
+    QSet<AppId> idSet;
+    for (const ItemInfo_v1 &info : cachedList) {
+        const AppId id = installedAppId(info);
+        if (id == AppInfoStore::InvalidId || idSet.contains(id))
+            continue;
+
+        ItemInfo_v1 *record = m_appStore.record(id);
+        if (record->m_openCount == 0) {
+            record->m_openCount = info.m_openCount;
+            record->m_firstRunTime = info.m_firstRunTime;
         }
+
+        idSet.insert(id);
+        ids.append(id);
+    }
+
+    return ids;
+}
+
+void AppsManager::removeNonexistentData()
+{
+    // 移除 m_appInfos 中已经不存在或分类已变化的应用, 应用信息由记录表统一更新
+    QHash<AppsListModel::AppCategory, AppIdList>::iterator categoryAppsIter = m_appInfos.begin();
+    for (; categoryAppsIter != m_appInfos.end(); ++categoryAppsIter) {
+        const AppsListModel::AppCategory category = categoryAppsIter.key();
+        AppIdList &ids = categoryAppsIter.value();
+        auto it = std::remove_if(ids.begin(), ids.end(), [ & ](const AppId id) {
+            return !m_appStore.contains(id) || m_appStore.info(id).category() != category;
+        });
+        ids.erase(it, ids.end());
     }
 
     // 移除 m_fullscreenUsedSortedList 所有应用中不存在的应用
@@ -589,23 +682,21 @@ void AppsManager::removeNonexistentData()
         if (info.m_isDir) {
             // 从文件夹中移除不存在的应用
             for (ItemInfo_v1 &dirItem : info.m_appInfoList) {
-                if (!contains(m_allAppInfoList, dirItem)) {
+                const AppId id = installedAppId(dirItem);
+                if (id == AppInfoStore::InvalidId) {
                     appListToRemove.append(dirItem);
                 } else {
                     // 多语言时，更新应用信息
-                    int index = itemIndex(m_allAppInfoList, dirItem);
-                    if (index != -1)
-                        dirItem.updateInfo(m_allAppInfoList[index]);
+                    dirItem.updateInfo(m_appStore.info(id));
                 }
             }
         } else {
-            if (!contains(m_allAppInfoList, info)) {
+            const AppId id = installedAppId(info);
+            if (id == AppInfoStore::InvalidId) {
                 appListToRemove.append(info);
             } else {
                 // 多语言时，更新应用信息
-                int index = itemIndex(m_allAppInfoList, info);
-                if (index != -1)
-                    info.updateInfo(m_allAppInfoList[index]);
+                info.updateInfo(m_appStore.info(id));
             }
         }
     }
@@ -626,10 +717,14 @@ void AppsManager::removeNonexistentData()
                         m_dirAppInfoList.clear();
                         itemInfo.m_appInfoList.clear();
 
+                        // 插入元素后列表可能重新分配内存, 先复制文件夹信息再移除
+                        const ItemInfo_v1 dirItemInfo = itemInfo;
                         m_fullscreenUsedSortedList.insert(originDirAppRow, insertItemInfo);
-                        m_fullscreenUsedSortedList.removeOne(itemInfo);
+                        m_fullscreenUsedSortedList.removeOne(dirItemInfo);
                         emit dataChanged(AppsListModel::FullscreenAll);
                     }
+
+                    break;
                 }
             }
         }
@@ -638,7 +733,7 @@ void AppsManager::removeNonexistentData()
     auto removeItems = [ & ](ItemInfoList_v1 &list) {
         ItemInfoList_v1 listToRemove;
         for (const ItemInfo_v1 &info : list) {
-            if (!contains(m_allAppInfoList, info))
+            if (installedAppId(info) == AppInfoStore::InvalidId)
                 listToRemove.append(info);
         }
 
@@ -650,7 +745,10 @@ void AppsManager::removeNonexistentData()
     removeItems(m_favoriteSortedList);
 
     // 移除 m_windowedUsedSortedList 中不存在的应用
-    removeItems(m_windowedUsedSortedList);
+    auto windowedIt = std::remove_if(m_windowedUsedSortedList.begin(), m_windowedUsedSortedList.end(), [ & ](const AppId id) {
+        return !m_appStore.contains(id);
+    });
+    m_windowedUsedSortedList.erase(windowedIt, m_windowedUsedSortedList.end());
 }
 
 /** 根据应用分类 ID 对应用分类列表进行排序
@@ -660,10 +758,10 @@ void AppsManager::getCategoryListAndSortCategoryId()
 {
     // 获取应用分类ID列表
     QList<qlonglong> categoryID;
-    for (const ItemInfo_v1 &itemInfo : m_allAppInfoList) {
-        if (!categoryID.contains(itemInfo.m_categoryId)) {
-            categoryID.append(itemInfo.m_categoryId);
-        }
+    for (const AppId id : m_allAppIds) {
+        const qlonglong categoryId = m_appStore.info(id).m_categoryId;
+        if (!categoryID.contains(categoryId))
+            categoryID.append(categoryId);
     }
 
     m_categoryList.clear();
@@ -930,13 +1028,9 @@ void AppsManager::insertDropItem(int pos)
  */
 void AppsManager::abandonStashedItem(const QString &desktop)
 {
-    // 遍历应用列表,存在则从列表中移除
-    for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            APP_AUTOSTART_CACHE.remove(info.m_desktop);
-            break;
-        }
-    }
+    // 应用存在则从自启动缓存中移除
+    if (m_appStore.find(desktop) != AppInfoStore::InvalidId)
+        APP_AUTOSTART_CACHE.remove(desktop);
 
     //重新获取分类数据，类似wps一个appkey对应多个desktop文件的时候,有可能会导致漏掉
     refreshCategoryInfoList();
@@ -981,6 +1075,82 @@ void AppsManager::restoreItem(const QString &desktop, AppsListModel::AppCategory
     }
 }
 
+/**
+ * @brief AppsManager::movableList 获取可以在其中移动应用的列表
+ * @param mode 列表类型
+ * @return 列表不支持移动或当前文件夹不存在时返回空指针
+ */
+ItemInfoList_v1 *AppsManager::movableList(AppsListModel::AppCategory mode)
+{
+    switch (mode) {
+    case AppsListModel::FullscreenAll:
+        return &m_fullscreenUsedSortedList;
+    case AppsListModel::Favorite:
+        return &m_favoriteSortedList;
+    case AppsListModel::Dir:
+        for (ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
+            if (info.m_isDir && info.m_appInfoList == m_dirAppInfoList)
+                return &info.m_appInfoList;
+        }
+        return nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * @brief AppsManager::canMoveItem 检查应用能否在列表内移动, 不修改列表
+ * @param mode 列表类型
+ * @param from 应用原来的位置
+ * @param to 应用移动后的位置
+ * @return 列表支持移动且两个位置都有效时返回 true
+ */
+bool AppsManager::canMoveItem(AppsListModel::AppCategory mode, int from, int to)
+{
+    const ItemInfoList_v1 *list = movableList(mode);
+    return list && from >= 0 && to >= 0 && from < list->size() && to < list->size();
+}
+
+/**
+ * @brief AppsManager::moveItem 在列表内移动应用, 只移动两个位置之间的元素, 不会重新分配列表内存
+ * @param mode 列表类型
+ * @param from 应用原来的位置
+ * @param to 应用移动后的位置
+ * @return 移动成功返回 true, 失败时列表保持不变
+ */
+bool AppsManager::moveItem(AppsListModel::AppCategory mode, int from, int to)
+{
+    if (!canMoveItem(mode, from, to))
+        return false;
+
+    auto moveInList = [ from, to ](ItemInfoList_v1 &list) {
+        if (from < to)
+            std::rotate(list.begin() + from, list.begin() + from + 1, list.begin() + to + 1);
+        else if (from > to)
+            std::rotate(list.begin() + to, list.begin() + from, list.begin() + from + 1);
+    };
+
+    moveInList(*movableList(mode));
+
+    switch (mode) {
+    case AppsListModel::FullscreenAll:
+        saveFullscreenUsedSortedList();
+        break;
+    case AppsListModel::Favorite:
+        saveCollectedSortedList();
+        break;
+    case AppsListModel::Dir:
+        // 文件夹中显示的是本地变量缓存的内容，两者保持一致
+        moveInList(m_dirAppInfoList);
+        saveFullscreenUsedSortedList();
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
 int AppsManager::dockPosition() const
 {
     return m_amDbusDockInter->position();
@@ -993,7 +1163,7 @@ QRect AppsManager::dockGeometry() const
 
 bool AppsManager::isVaild()
 {
-    return m_amDbusLauncherInter->isValid() && !m_allAppInfoList.isEmpty();
+    return m_amDbusLauncherInter->isValid() && !m_allAppIds.isEmpty();
 }
 
 void AppsManager::refreshAllList()
@@ -1006,7 +1176,43 @@ void AppsManager::refreshAllList()
 
 void AppsManager::saveWidowedUsedSortedList()
 {
-    m_windowedUsedSortSetting->setValue("lists", getCacheMapData(m_windowedUsedSortedList));
+    m_windowedUsedSortSetting->setValue("lists", getCacheMapData(m_appStore.infoList(m_windowedUsedSortedList)));
+    m_windowedUsedSortSetting->setValue("frecency", m_frecencyRanker.toVariantMap());
+}
+
+/**
+ * @brief AppsManager::refreshNewInstalledApps 获取新安装的应用集合
+ */
+void AppsManager::refreshNewInstalledApps()
+{
+    // TODO: 这个接口返回数据存在异常
+    QStringList newInstalledApps;
+    if (AMInter::isAMReborn()) {
+        newInstalledApps = AMInter::instance()->allNewInstalledApps();
+    } else {
+        newInstalledApps = m_amDbusLauncherInter->GetAllNewInstalledApps().value();
+    }
+
+    m_newInstalledApps.clear();
+    m_newInstalledApps.reserve(newInstalledApps.size());
+    for (const QString &appKey : newInstalledApps)
+        m_newInstalledApps.insert(appKey);
+}
+
+/**
+ * @brief AppsManager::loadFrecencyData 读取应用使用频率排名的缓存数据
+ * 历史版本的缓存中只有打开次数, 以打开次数作为应用的初始分值
+ * @param cachedList 小窗口应用列表的缓存数据
+ */
+void AppsManager::loadFrecencyData(const ItemInfoList_v1 &cachedList)
+{
+    m_frecencyRanker.fromVariantMap(m_windowedUsedSortSetting->value("frecency").toMap());
+
+    const qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+    for (const ItemInfo_v1 &info : cachedList) {
+        if (!m_frecencyRanker.contains(info.m_desktop))
+            m_frecencyRanker.seed(info.m_desktop, info.m_openCount, currentTime);
+    }
 }
 
 void AppsManager::saveFullscreenUsedSortedList()
@@ -1046,15 +1252,14 @@ void AppsManager::launchApp(const QModelIndex &index)
         m_startManagerInter->Launch(desktop);
     }
     // 更新应用的打开次数以及首次启动的时间戳
-    for (ItemInfo_v1 &info: m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            ++info.m_openCount;
-            if (info.m_firstRunTime == 0)
-                info.m_firstRunTime = QDateTime::currentMSecsSinceEpoch() / 1000;
-
-            break;
-        }
+    const qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+    ItemInfo_v1 *info = m_appStore.record(m_appStore.find(desktop));
+    if (info) {
+        ++info->m_openCount;
+        if (info->m_firstRunTime == 0)
+            info->m_firstRunTime = currentTime;
     }
+    m_frecencyRanker.recordLaunch(desktop, currentTime);
 
     refreshItemInfoList();
     markLaunched(m_clickedItemInfo.m_key);
@@ -1089,16 +1294,20 @@ void AppsManager::onEditCollected(const QModelIndex index, const bool isInCollec
         return;
 
     const ItemInfo_v1 &info = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
+    const int row = itemIndex(m_favoriteSortedList, info);
     if (!isInCollected) {
-        if (itemIndex(m_favoriteSortedList, info) == -1)
-            m_favoriteSortedList.append(info);
+        if (row != -1)
+            return;
+
+        insertListItem(AppsListModel::Favorite, m_favoriteSortedList, m_favoriteSortedList.size(), info);
     } else {
-        if (itemIndex(m_favoriteSortedList, info) != -1)
-            m_favoriteSortedList.removeOne(info);
+        if (row == -1)
+            return;
+
+        removeListItem(AppsListModel::Favorite, m_favoriteSortedList, row);
     }
 
     saveCollectedSortedList();
-    emit dataChanged(AppsListModel::Favorite);
 }
 
 void AppsManager::onMoveToFirstInCollected(const QModelIndex index)
@@ -1107,45 +1316,248 @@ void AppsManager::onMoveToFirstInCollected(const QModelIndex index)
         return;
 
     ItemInfo_v1 info = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
-    if (itemIndex(m_favoriteSortedList, info) != -1) {
-        m_favoriteSortedList.removeOne(info);
-        m_favoriteSortedList.insert(0, info);
-    }
+    const int row = itemIndex(m_favoriteSortedList, info);
+    if (row <= 0)
+        return;
+
+    const AppsChange change = AppsChange::moved(row, 0);
+    emit itemsAboutToChange(AppsListModel::Favorite, change);
+    std::rotate(m_favoriteSortedList.begin(), m_favoriteSortedList.begin() + row, m_favoriteSortedList.begin() + row + 1);
+    emit itemsChanged(AppsListModel::Favorite, change);
 
     saveCollectedSortedList();
-    emit dataChanged(AppsListModel::Favorite);
 }
 
 void AppsManager::markLaunched(const QString &appKey)
 {
-    if (appKey.isEmpty() || !m_newInstalledAppsList.contains(appKey))
+    if (appKey.isEmpty() || !m_newInstalledApps.remove(appKey))
         return;
 
-    m_newInstalledAppsList.removeOne(appKey);
+    notifyItemsUpdated([ & ](const ItemInfo_v1 &info) {
+        return info.m_key == appKey;
+    }, { AppsListModel::AppNewInstallRole });
+}
 
-    emit dataChanged(AppsListModel::FullscreenAll);
+/**
+ * @brief AppsManager::insertListItem 向列表中插入应用, 并通知对应的模型插入一行
+ * @param category 列表类型
+ * @param list 列表
+ * @param row 插入的位置
+ * @param info 应用信息
+ */
+void AppsManager::insertListItem(AppsListModel::AppCategory category, ItemInfoList_v1 &list, int row, const ItemInfo_v1 &info)
+{
+    const AppsChange change = AppsChange::inserted(row, row);
+    emit itemsAboutToChange(category, change);
+    list.insert(row, info);
+    emit itemsChanged(category, change);
+}
+
+/**
+ * @brief AppsManager::removeListItem 从列表中移除应用, 并通知对应的模型移除一行
+ * @param category 列表类型
+ * @param list 列表
+ * @param row 移除的位置
+ */
+void AppsManager::removeListItem(AppsListModel::AppCategory category, ItemInfoList_v1 &list, int row)
+{
+    const AppsChange change = AppsChange::removed(row, row);
+    emit itemsAboutToChange(category, change);
+    list.removeAt(row);
+    emit itemsChanged(category, change);
+}
+
+/**
+ * @brief AppsManager::insertListItem 向记录 id 列表中插入应用, 并通知对应的模型插入一行
+ * @param category 列表类型
+ * @param ids 记录 id 列表
+ * @param row 插入的位置
+ * @param id 应用的记录 id
+ */
+void AppsManager::insertListItem(AppsListModel::AppCategory category, AppIdList &ids, int row, AppId id)
+{
+    const AppsChange change = AppsChange::inserted(row, row);
+    emit itemsAboutToChange(category, change);
+    ids.insert(row, id);
+    emit itemsChanged(category, change);
+}
+
+void AppsManager::removeListItem(AppsListModel::AppCategory category, AppIdList &ids, int row)
+{
+    const AppsChange change = AppsChange::removed(row, row);
+    emit itemsAboutToChange(category, change);
+    ids.removeAt(row);
+    emit itemsChanged(category, change);
+}
+
+/**
+ * @brief AppsManager::notifyItemsUpdated 通知各列表中符合条件的应用数据发生变化, 列表结构不变
+ * @param match 应用的匹配条件
+ * @param roles 发生变化的数据角色
+ */
+void AppsManager::notifyItemsUpdated(const std::function<bool(const ItemInfo_v1 &)> &match, const QVector<int> &roles)
+{
+    auto notifyList = [ & ](AppsListModel::AppCategory category, const ItemInfoList_v1 &list) {
+        for (int i = 0; i < list.size(); i++) {
+            if (match(list.at(i)))
+                emit itemsChanged(category, AppsChange::updated(i, i, roles));
+        }
+    };
+
+    auto notifyIdList = [ & ](AppsListModel::AppCategory category, const AppIdList &ids) {
+        for (int i = 0; i < ids.size(); i++) {
+            if (match(m_appStore.info(ids.at(i))))
+                emit itemsChanged(category, AppsChange::updated(i, i, roles));
+        }
+    };
+
+    notifyList(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList);
+    notifyIdList(AppsListModel::WindowedAll, m_windowedUsedSortedList);
+    notifyList(AppsListModel::Favorite, m_favoriteSortedList);
+    notifyList(AppsListModel::Dir, m_dirAppInfoList);
+    notifyIdList(AppsListModel::PluginSearch, m_appSearchResultList);
+    notifyIdList(AppsListModel::TitleMode, m_appCategoryInfos);
+    notifyIdList(AppsListModel::LetterMode, m_appLetterModeInfos);
+    for (auto it = m_appInfos.cbegin(); it != m_appInfos.cend(); ++it)
+        notifyIdList(it.key(), it.value());
 }
 
 void AppsManager::delayRefreshData()
 {
-    // TODO: 这个接口返回数据存在异常
-    if (AMInter::isAMReborn()) {
-        m_newInstalledAppsList = AMInter::instance()->allNewInstalledApps();
-    } else {
-        m_newInstalledAppsList = m_amDbusLauncherInter->GetAllNewInstalledApps().value();
-    }
+    refreshNewInstalledApps();
     refreshCategoryInfoList();
 
     emit dataChanged(AppsListModel::FullscreenAll);
 }
 
 /**
- * @brief AppsManager::refreshIcon 刷新当前安装/卸载/更新的应用图标
+ * @brief AppsManager::refreshIcon 图标目录发生变化后, 仅重新查找未获取到图标的应用, 找到后刷新对应的列表项
  */
 void AppsManager::refreshIcon()
 {
-    // 更新单个应用信息
-    appIcon(m_itemInfo);
+    // 目录中已有的图标文件也可能被替换, 已缓存的图标需要重新查找
+    clearIconCache();
+
+    if (m_pendingIconItems.isEmpty())
+        return;
+
+    // QIcon::fromTheme 会缓存查找失败的结果, 重新设置搜索路径以清空主题缓存
+    QIcon::setThemeSearchPaths(QIcon::themeSearchPaths());
+
+    ItemInfoList_v1 resolvedList;
+    for (auto it = m_pendingIconItems.begin(); it != m_pendingIconItems.end();) {
+        QPixmap pix;
+        if (getThemeIcon(pix, it.value(), 0)) {
+            resolvedList.append(it.value());
+            it = m_pendingIconItems.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // 没有待查找的图标时取消监听, 避免无意义的唤醒
+    if (m_pendingIconItems.isEmpty()) {
+        const QStringList dirs = m_iconDirWatcher->directories();
+        if (!dirs.isEmpty())
+            m_iconDirWatcher->removePaths(dirs);
+    }
+
+    for (const ItemInfo_v1 &info : resolvedList)
+        emit itemDataChanged(info);
+}
+
+/**
+ * @brief AppsManager::clearIconCache 清空已找到的应用图标, 通知界面重新获取图标
+ */
+void AppsManager::clearIconCache()
+{
+    appIconCache().clear();
+    emit iconsChanged();
+}
+
+/**
+ * @brief AppsManager::removeIconCache 移除应用已缓存的图标
+ * @param desktop 应用 desktop 文件路径
+ */
+void AppsManager::removeIconCache(const QString &desktop)
+{
+    const QString prefix = desktop + QLatin1Char('_');
+    for (const QString &key : appIconCache().keys()) {
+        if (key.startsWith(prefix))
+            appIconCache().remove(key);
+    }
+}
+
+void AppsManager::onIconDirectoryChanged(const QString &path)
+{
+    Q_UNUSED(path);
+
+    if (!m_refreshIconTimer->isActive())
+        m_refreshIconTimer->start();
+}
+
+/**
+ * @brief AppsManager::addPendingIcon 记录未找到图标的应用, 等待图标目录变化后再查找
+ * @param info 应用信息
+ */
+void AppsManager::addPendingIcon(const ItemInfo_v1 &info)
+{
+    const QString key = cacheKey(info);
+    if (m_pendingIconItems.contains(key))
+        return;
+
+    const bool needWatch = m_pendingIconItems.isEmpty();
+    m_pendingIconItems.insert(key, info);
+
+    // 图标为绝对路径时, 监听其所在目录
+    if (QDir::isAbsolutePath(info.m_iconKey)) {
+        const QString dirPath = QFileInfo(info.m_iconKey).absolutePath();
+        if (QFileInfo::exists(dirPath) && !m_iconDirWatcher->directories().contains(dirPath))
+            m_iconDirWatcher->addPath(dirPath);
+    }
+
+    if (needWatch)
+        watchIconDirectories();
+}
+
+/**
+ * @brief AppsManager::watchIconDirectories 监听 hicolor、当前图标主题下各尺寸的 apps 目录以及 /usr/share/pixmaps
+ */
+void AppsManager::watchIconDirectories()
+{
+    QStringList themeNames;
+    themeNames << QStringLiteral("hicolor");
+    if (!QIcon::themeName().isEmpty() && QIcon::themeName() != QLatin1String("hicolor"))
+        themeNames << QIcon::themeName();
+
+    QStringList dirs;
+    for (const QString &searchPath : QIcon::themeSearchPaths()) {
+        // 跳过 qrc 资源路径
+        if (searchPath.startsWith(":"))
+            continue;
+
+        for (const QString &themeName : themeNames) {
+            const QDir themeDir(searchPath + "/" + themeName);
+            if (!themeDir.exists())
+                continue;
+
+            for (const QString &sizeDir : themeDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                const QString appsDir = themeDir.absoluteFilePath(sizeDir + "/apps");
+                if (QFileInfo(appsDir).isDir())
+                    dirs << appsDir;
+            }
+        }
+    }
+
+    const QString pixmapsDir = QStringLiteral("/usr/share/pixmaps");
+    if (QFileInfo(pixmapsDir).isDir())
+        dirs << pixmapsDir;
+
+    const QStringList watchedDirs = m_iconDirWatcher->directories();
+    for (const QString &dir : dirs) {
+        if (!watchedDirs.contains(dir))
+            m_iconDirWatcher->addPath(dir);
+    }
 }
 
 bool AppsManager::fuzzyMatching(const QStringList& list, const QString& key)
@@ -1158,16 +1570,6 @@ bool AppsManager::fuzzyMatching(const QStringList& list, const QString& key)
     return false;
 }
 
-void AppsManager::onRefreshCalendarTimer()
-{
-    m_curDate = QDate::currentDate();
-
-    if(m_lastShowDate != m_curDate.day()) {
-        delayRefreshData();
-        m_lastShowDate = m_curDate.day();
-    }
-}
-
 void AppsManager::onGSettingChanged(const QString &keyName)
 {
     if (keyName != "filter-keys" && keyName != "filterKeys")
@@ -1226,25 +1628,23 @@ const ItemInfoList_v1 AppsManager::appsInfoList(const AppsListModel::AppCategory
 {
     switch (category) {
     case AppsListModel::TitleMode:
-        return m_appCategoryInfos;
+        return m_appStore.infoList(m_appCategoryInfos);
     case AppsListModel::LetterMode:
-        return m_appLetterModeInfos;
+        return m_appStore.infoList(m_appLetterModeInfos);
     case AppsListModel::WindowedAll:
-        return m_windowedUsedSortedList;
+        return m_appStore.infoList(m_windowedUsedSortedList);
     case AppsListModel::FullscreenAll:
         return m_fullscreenUsedSortedList;
     case AppsListModel::Search:
     case AppsListModel::PluginSearch:
-        return m_appSearchResultList;
+        return m_appStore.infoList(m_appSearchResultList);
     case AppsListModel::Favorite:
         return m_favoriteSortedList;
     default:
         break;
     }
 
-    ItemInfoList_v1 ItemInfoList_v1;
-    ItemInfoList_v1.append(m_appInfos[category]);
-    return ItemInfoList_v1;
+    return m_appStore.infoList(m_appInfos.value(category));
 }
 
 int AppsManager::appsInfoListSize(const AppsListModel::AppCategory &category)
@@ -1278,37 +1678,94 @@ const ItemInfo_v1 AppsManager::appsInfoListIndex(const AppsListModel::AppCategor
     switch (category) {
     case AppsListModel::TitleMode:
         Q_ASSERT(m_appCategoryInfos.size() > index);
-        return m_appCategoryInfos[index];
+        return m_appStore.info(m_appCategoryInfos[index]);
     case AppsListModel::LetterMode:
         Q_ASSERT(m_appLetterModeInfos.size() > index);
-        return m_appLetterModeInfos[index];
+        return m_appStore.info(m_appLetterModeInfos[index]);
     case AppsListModel::Favorite:
         Q_ASSERT(m_favoriteSortedList.size() > index);
         return m_favoriteSortedList[index];
     case AppsListModel::WindowedAll:
         Q_ASSERT(m_windowedUsedSortedList.size() > index);
-        return m_windowedUsedSortedList[index];
+        return m_appStore.info(m_windowedUsedSortedList[index]);
     case AppsListModel::Search:
         Q_ASSERT(m_windowedUsedSortedList.size() > index);
-        return m_windowedUsedSortedList[index];
+        return m_appStore.info(m_windowedUsedSortedList[index]);
     case AppsListModel::FullscreenAll:
         Q_ASSERT(m_fullscreenUsedSortedList.size() > index);
         return m_fullscreenUsedSortedList[index];
     case AppsListModel::PluginSearch:
         Q_ASSERT(m_appSearchResultList.size() > index);
-        return m_appSearchResultList[index];
+        return m_appStore.info(m_appSearchResultList[index]);
     case AppsListModel::Dir:
         return m_dirAppInfoList[index];
     default:
         break;
     }
 
-    ItemInfo_v1 itemInfo;
-
     Q_ASSERT(m_appInfos[category].size() > index);
-    itemInfo = m_appInfos[category][index];
+    return m_appStore.info(m_appInfos[category][index]);
+}
+
+/**
+ * @brief AppsManager::itemIndexes 获取应用在列表中的位置, 包含该应用的文件夹也一并返回
+ * @param category 列表类型
+ * @param info 应用信息
+ * @return 应用或包含该应用的文件夹在列表中的位置, 只比较记录 id 或应用 key, 不复制应用信息
+ */
+QVector<int> AppsManager::itemIndexes(const AppsListModel::AppCategory category, const ItemInfo_v1 &info) const
+{
+    QVector<int> indexes;
+
+    auto findInIds = [ & ](const AppIdList &ids) {
+        const AppId id = m_appStore.find(info.m_desktop);
+        for (int i = 0; id != AppInfoStore::InvalidId && i < ids.size(); i++) {
+            if (ids.at(i) == id)
+                indexes.append(i);
+        }
+    };
+
+    auto findInList = [ & ](const ItemInfoList_v1 &list) {
+        auto isChangedItem = [ &info ](const ItemInfo_v1 &itemInfo) {
+            return itemInfo.m_key == info.m_key;
+        };
+
+        for (int i = 0; i < list.size(); i++) {
+            const ItemInfo_v1 &itemInfo = list.at(i);
+            if (isChangedItem(itemInfo) || (itemInfo.m_isDir && std::any_of(itemInfo.m_appInfoList.cbegin(), itemInfo.m_appInfoList.cend(), isChangedItem)))
+                indexes.append(i);
+        }
+    };
 
-    return itemInfo;
+    switch (category) {
+    case AppsListModel::TitleMode:
+        findInIds(m_appCategoryInfos);
+        break;
+    case AppsListModel::LetterMode:
+        findInIds(m_appLetterModeInfos);
+        break;
+    case AppsListModel::WindowedAll:
+    case AppsListModel::Search:
+        findInIds(m_windowedUsedSortedList);
+        break;
+    case AppsListModel::PluginSearch:
+        findInIds(m_appSearchResultList);
+        break;
+    case AppsListModel::Favorite:
+        findInList(m_favoriteSortedList);
+        break;
+    case AppsListModel::FullscreenAll:
+        findInList(m_fullscreenUsedSortedList);
+        break;
+    case AppsListModel::Dir:
+        findInList(m_dirAppInfoList);
+        break;
+    default:
+        findInIds(m_appInfos.value(category));
+        break;
+    }
+
+    return indexes;
 }
 
 const ItemInfo_v1 AppsManager::appsCategoryListIndex(const int index)
@@ -1316,7 +1773,7 @@ const ItemInfo_v1 AppsManager::appsCategoryListIndex(const int index)
     if (index > m_appCategoryInfos.size() - 1)
         return ItemInfo_v1();
 
-    return m_appCategoryInfos.at(index);
+    return m_appStore.info(m_appCategoryInfos.at(index));
 }
 
 const ItemInfo_v1 AppsManager::appsLetterListIndex(const int index)
@@ -1324,10 +1781,10 @@ const ItemInfo_v1 AppsManager::appsLetterListIndex(const int index)
     if (index > m_appLetterModeInfos.size() - 1)
         return ItemInfo_v1();
 
-    return m_appLetterModeInfos.at(index);
+    return m_appStore.info(m_appLetterModeInfos.at(index));
 }
 
-const ItemInfoList_v1 &AppsManager::windowedFrameItemInfoList()
+const AppIdList &AppsManager::windowedFrameItemInfoList()
 {
     return m_appCategoryInfos;
 }
@@ -1356,14 +1813,14 @@ void AppsManager::setDirAppInfoList(const QModelIndex index)
     emit dataChanged(AppsListModel::FullscreenAll);
 }
 
-const QHash<AppsListModel::AppCategory, ItemInfoList_v1> &AppsManager::categoryList()
+const QHash<AppsListModel::AppCategory, AppIdList> &AppsManager::categoryList()
 {
     return m_appInfos;
 }
 
 bool AppsManager::appIsNewInstall(const QString &key)
 {
-    return m_newInstalledAppsList.contains(key);
+    return m_newInstalledApps.contains(key);
 }
 
 bool AppsManager::appIsAutoStart(const QString &desktop)
@@ -1376,6 +1833,21 @@ bool AppsManager::appIsOnDock(const QString &desktop)
     return m_amDbusDockInter->IsDocked(desktop);
 }
 
+/**
+ * @brief AppsManager::appIsFavorite 判断应用是否已收藏
+ * @param desktop 应用的 desktop 文件路径
+ * @return 在收藏列表中返回 true, 否则返回 false, 直接遍历收藏列表不复制
+ */
+bool AppsManager::appIsFavorite(const QString &desktop) const
+{
+    for (const ItemInfo_v1 &info : m_favoriteSortedList) {
+        if (info.m_desktop == desktop)
+            return true;
+    }
+
+    return false;
+}
+
 bool AppsManager::appIsOnDesktop(const QString &desktop)
 {
     if (AMInter::isAMReborn()) {
@@ -1410,46 +1882,56 @@ const QPixmap AppsManager::appIcon(const ItemInfo_v1 &info, const int size)
     QPixmap pix;
     const int iconSize = perfectIconSize(size);
 
-    m_itemInfo = info;
+    // 日历图标每天变化, 由 calendarIcon 自行缓存
+    const bool cacheable = !info.m_desktop.contains("/dde-calendar.desktop");
+    const QString key = QString("%1_%2_%3_%4_%5").arg(info.m_desktop).arg(QIcon::themeName()).arg(info.m_iconKey)
+            .arg(iconSize).arg(qApp->devicePixelRatio());
+    const QPixmap *cachedPix = cacheable ? appIconCache().object(key) : nullptr;
+    if (cachedPix) {
+        m_iconValid = true;
+        return *cachedPix;
+    }
+
     m_iconValid = getThemeIcon(pix, info, size);
     if (m_iconValid) {
-        m_tryNums = 0;
+        if (cacheable)
+            appIconCache().insert(key, new QPixmap(pix), pix.width() * pix.height() * pix.depth() / 8);
+
         return pix;
     }
 
-    // 先返回齿轮，然后继续找
+    // 先返回齿轮，等图标目录发生变化后再查找
     qreal ratio = qApp->devicePixelRatio();
     QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
     pix = icon.pixmap(QSize(iconSize, iconSize) * ratio);
     pix.setDevicePixelRatio(ratio);
 
-    if (m_tryNums < 10) {
-        ++m_tryNums;
-
-        if (!QFile::exists(info.m_iconKey))
-            QIcon::setThemeSearchPaths(QIcon::themeSearchPaths());
+    addPendingIcon(info);
 
-        QTimer::singleShot(5 * 1000, this, &AppsManager::refreshIcon);
-    } else {
-        if (m_tryCount > 10)
-            return pix;
-
-        ++m_tryCount;
-        QTimer::singleShot(10 * 1000, this, &AppsManager::refreshIcon);
-    }
     return pix;
 }
 
 const QString AppsManager::appName(const ItemInfo_v1 &info, const int size)
 {
     const QFontMetrics fm = qApp->fontMetrics();
-    bool showSuffix = ConfigWorker::getValue(DLauncher::SHOW_LINGLONG_SUFFIX).toBool();
-    bool isLingLongApp = info.isLingLongApp();
-    const QString &displayName = (showSuffix && isLingLongApp) ? (QString("%1(%2)").arg(info.m_name).arg(tr("LingLong"))) : info.m_name;
-    const QString &fm_string = fm.elidedText(displayName, Qt::ElideRight, size);
+    const QString &fm_string = fm.elidedText(appDisplayName(info), Qt::ElideRight, size);
     return fm_string;
 }
 
+/**
+ * @brief AppsManager::appDisplayName 获取应用显示的名称
+ * @param info 应用信息
+ * @return 开启玲珑后缀配置时玲珑应用名称带后缀, 不做省略处理
+ */
+const QString AppsManager::appDisplayName(const ItemInfo_v1 &info)
+{
+    const bool showSuffix = ConfigWorker::snapshot()->showLingLongSuffix;
+    if (showSuffix && info.isLingLongApp() && !info.m_isDir)
+        return QString("%1(%2)").arg(info.m_name).arg(tr("LingLong"));
+
+    return info.m_name;
+}
+
 void AppsManager::updateDataFromAllAppList(ItemInfoList_v1 &processList)
 {
     ItemInfoList_v1 dirAppInfoList;
@@ -1458,7 +1940,8 @@ void AppsManager::updateDataFromAllAppList(ItemInfoList_v1 &processList)
             dirAppInfoList.append(itemInfo.m_appInfoList);
     }
 
-    for (const ItemInfo_v1 &itemInfo : m_allAppInfoList) {
+    for (const AppId id : m_allAppIds) {
+        const ItemInfo_v1 &itemInfo = m_appStore.info(id);
         if (!contains(processList, itemInfo) && !contains(dirAppInfoList, itemInfo)) {
             processList.append(itemInfo);
         } else {
@@ -1492,29 +1975,44 @@ void AppsManager::refreshCategoryInfoList()
     } else {
         datas = ItemInfo_v1::itemV2ListToItemV1List(reply.value());
     }
-    m_allAppInfoList.clear();
-    m_allAppInfoList.reserve(datas.size());
-    for (const auto &info : datas) {
+    // 应用信息写入记录表, 同一应用的记录 id 保持不变
+    AppIdList allAppIds;
+    allAppIds.reserve(datas.size());
+    QSet<AppId> allAppIdSet;
+    for (ItemInfo_v1 &info : datas) {
         bool bContains = fuzzyMatching(filters, info.m_key);
         if (!m_stashList.contains(info) && !bContains) {
-            if (info.m_key == "dde-trash") {
-                ItemInfo_v1 trashItem = info;
-                trashItem.m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
-                m_allAppInfoList.append(trashItem);
-                continue;
-            }
+            if (info.m_key == "dde-trash")
+                info.m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
 
-            m_allAppInfoList.append(info);
+            // datas 仅在此处使用, 新应用的数据直接转移到记录表中
+            const AppId id = m_appStore.insert(std::move(info));
+            if (!allAppIdSet.contains(id)) {
+                allAppIdSet.insert(id);
+                allAppIds.append(id);
+            }
         }
     }
 
-    sortByPresetOrder(m_allAppInfoList);
+    // 移除已不存在的应用记录, 分类标题记录在 generateCategoryMap 中重新生成
+    m_allAppIds = allAppIds;
+    m_appStore.retain(m_allAppIds);
+
+    sortByPresetOrder(m_allAppIds);
 
     // 2. 读取小窗口所有应用列表的缓存数据
-    m_windowedUsedSortedList = readCacheData(m_windowedUsedSortSetting->value("lists").toMap());
+    ItemInfoList_v1 windowedCachedList = readCacheData(m_windowedUsedSortSetting->value("lists").toMap());
+
+    // 排名数据在应用启动时实时更新, 只需读取一次
+    if (m_frecencyRanker.size() == 0)
+        loadFrecencyData(windowedCachedList);
 
     // 所有应用列表有而小窗口缓存数据中没有的, 则加入到小窗口应用列表中
-    updateDataFromAllAppList(m_windowedUsedSortedList);
+    updateDataFromAllAppList(windowedCachedList);
+
+    // 小窗口列表没有文件夹等状态, 只保存记录 id, 应用信息由记录表统一更新
+    removeDuplicateData(windowedCachedList);
+    m_windowedUsedSortedList = installedAppIds(windowedCachedList);
 
     // 3. 读取全屏下所有应用列表的缓存数据
     // 为兼容历史版本, 1050以前使用list, v23即以后使用lists作为键值
@@ -1531,15 +2029,15 @@ void AppsManager::refreshCategoryInfoList()
     // 所有应用列表有而全屏缓存数据中没有的, 则加入到全屏应用列表中
     updateDataFromAllAppList(m_fullscreenUsedSortedList);
 
-    for (const ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
-        if (fuzzyMatching(filters, info.m_key))
-            m_fullscreenUsedSortedList.removeOne(info);
-    }
+    auto filterIt = std::remove_if(m_fullscreenUsedSortedList.begin(), m_fullscreenUsedSortedList.end(), [ & ](const ItemInfo_v1 &info) {
+        return fuzzyMatching(filters, info.m_key);
+    });
+    m_fullscreenUsedSortedList.erase(filterIt, m_fullscreenUsedSortedList.end());
 
     // 4. 从缓存中读取已分类的应用数据, 降低数据处理次数
     if (m_appInfos.isEmpty()) {
         for (int categoryIndex = AppsListModel::Internet; categoryIndex < static_cast<int>(AppsListModel::Others); categoryIndex++) {
-            ItemInfoList_v1 itemInfoList_v1 = m_appInfos.value(AppsListModel::AppCategory(categoryIndex));
+            ItemInfoList_v1 itemInfoList_v1;
 
             // 读取1050缓存的话，需要减去(v23阶段)新增的4个枚举变量的偏移值
             int originCategoryIndex = categoryIndex - 4;
@@ -1553,22 +2051,21 @@ void AppsManager::refreshCategoryInfoList()
                 itemInfoList_v1 = readCacheData(m_categorySetting->value(QString("lists_%1").arg(categoryIndex)).toMap());
             }
 
-            ItemInfoList_v1 list_ToRemove;
+            AppIdList categoryIds;
             for (const ItemInfo_v1 &info : itemInfoList_v1) {
-                int index = itemIndex(m_allAppInfoList, info);
+                const AppId id = m_appStore.find(info.m_desktop);
+                // 如果应用已经卸载，从更新缓存数据列表
+                if (id == AppInfoStore::InvalidId || categoryIds.contains(id))
+                    continue;
+
                 // 当缓存数据与应用商店数据有差异时，以应用商店数据为准
-                if (index != -1 && m_allAppInfoList.at(index).category() != info.category())
-                    list_ToRemove.append(info);
+                if (m_appStore.info(id).category() != info.category())
+                    continue;
 
-                // 如果应用已经卸载，从更新缓存数据列表
-                if (index == -1)
-                    list_ToRemove.append(info);
+                categoryIds.append(id);
             }
 
-            for (const ItemInfo_v1 &info : list_ToRemove)
-                itemInfoList_v1.removeOne(info);
-
-            m_appInfos.insert(AppsListModel::AppCategory(categoryIndex), itemInfoList_v1);
+            m_appInfos.insert(AppsListModel::AppCategory(categoryIndex), categoryIds);
 
             if (categoryIndex == static_cast<int>(AppsListModel::System) && QFileInfo::exists(APP_CATEGORY_USED_SORTED_LIST.fileName())) {
                 QDir removeCacheFileDir;
@@ -1579,25 +2076,20 @@ void AppsManager::refreshCategoryInfoList()
     }
 
     // 5. 获取新安装的应用列表
-    if (AMInter::isAMReborn()) {
-        m_newInstalledAppsList = AMInter::instance()->allNewInstalledApps();
-    } else {
-        m_newInstalledAppsList = m_amDbusLauncherInter->GetAllNewInstalledApps().value();
-    }
+    refreshNewInstalledApps();
 
     // 6. 清除不存在的数据
     removeNonexistentData();
 
     // 清理可能出现的重复数据
     removeDuplicateData(m_fullscreenUsedSortedList);
-    removeDuplicateData(m_windowedUsedSortedList);
     generateCategoryMap();
 }
 
 void AppsManager::refreshItemInfoList()
 {
     if (m_fullscreenUsedSortedList.isEmpty())
-        m_fullscreenUsedSortedList = m_allAppInfoList;
+        m_fullscreenUsedSortedList = m_appStore.infoList(m_allAppIds);
 
     // 获取所有文件夹下的应用列表
     ItemInfoList_v1 dirAppInfoList;
@@ -1607,35 +2099,36 @@ void AppsManager::refreshItemInfoList()
     }
 
     // 更新全屏窗口-所有应用列表
-    ItemInfoList_v1::ConstIterator allItemItor = m_allAppInfoList.constBegin();
-    for (; allItemItor != m_allAppInfoList.constEnd(); ++allItemItor) {
+    for (const AppId id : m_allAppIds) {
+        const ItemInfo_v1 &allItemInfo = m_appStore.info(id);
         // 在全屏列表中存在或者文件夹中存在时，就更新应用信息
         // 在全屏应用列表以及文件夹中都不存在时，才加入到最后
-        if (!contains(m_fullscreenUsedSortedList, *allItemItor)) {
-            for (ItemInfo_v1 &fullItemInfo : m_fullscreenUsedSortedList) {
+        if (!contains(m_fullscreenUsedSortedList, allItemInfo)) {
+            // 不能在遍历列表时向列表中追加元素, 先判断是否在文件夹中
+            if (!contains(dirAppInfoList, allItemInfo)) {
+                m_fullscreenUsedSortedList.append(allItemInfo);
+                continue;
+            }
 
+            for (ItemInfo_v1 &fullItemInfo : m_fullscreenUsedSortedList) {
                 if (!fullItemInfo.m_isDir)
                     continue;
 
-                if (!contains(dirAppInfoList, *allItemItor)) {
-                    m_fullscreenUsedSortedList.append(*allItemItor);
-                } else {
-                    int index = itemIndex(fullItemInfo.m_appInfoList, *allItemItor);
-                    if (index != -1)
-                        fullItemInfo.m_appInfoList[index].updateInfo(*allItemItor);
-                }
+                int index = itemIndex(fullItemInfo.m_appInfoList, allItemInfo);
+                if (index != -1)
+                    fullItemInfo.m_appInfoList[index].updateInfo(allItemInfo);
             }
         } else {
             // 更新应用信息(譬如，语言切换时会受用）
-            int index = itemIndex(m_fullscreenUsedSortedList, *allItemItor);
+            int index = itemIndex(m_fullscreenUsedSortedList, allItemInfo);
             if (index != -1)
-                m_fullscreenUsedSortedList[index].updateInfo(*allItemItor);
+                m_fullscreenUsedSortedList[index].updateInfo(allItemInfo);
         }
     }
 
     ItemInfoList_v1 list_toRemove;
     for (const ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
-        if (!contains(m_allAppInfoList, info))
+        if (installedAppId(info) == AppInfoStore::InvalidId)
             list_toRemove.append(info);
     }
 
@@ -1645,7 +2138,7 @@ void AppsManager::refreshItemInfoList()
         // 否则，将文件夹中本地不存在的应用删除
         if (info.m_isDir) {
             for (const ItemInfo_v1 &appInfo : info.m_appInfoList) {
-                if (!contains(m_allAppInfoList, appInfo)) {
+                if (installedAppId(appInfo) == AppInfoStore::InvalidId) {
                     const int index = itemIndex(m_fullscreenUsedSortedList, info);
                     m_fullscreenUsedSortedList[index].m_appInfoList.removeOne(appInfo);
                 }
@@ -1662,32 +2155,28 @@ void AppsManager::refreshItemInfoList()
             m_fullscreenUsedSortedList.removeOne(dirItemInfo);
     }
 
-    // 移除小窗口-所有应用列表中不存在的应用
-    // 更新应用信息
-    for (ItemInfo_v1 &info : m_windowedUsedSortedList) {
-        if (!contains(m_allAppInfoList, info)) {
-            m_windowedUsedSortedList.removeOne(info);
-        } else {
-            int index = itemIndex(m_allAppInfoList, info);
-            info.updateInfo(m_allAppInfoList.at(index));
-        }
-    }
+    // 移除小窗口-所有应用列表中不存在的应用, 应用信息已在记录表中更新
+    auto windowedIt = std::remove_if(m_windowedUsedSortedList.begin(), m_windowedUsedSortedList.end(), [ & ](const AppId id) {
+        return !m_appStore.contains(id);
+    });
+    m_windowedUsedSortedList.erase(windowedIt, m_windowedUsedSortedList.end());
 
     // 移除收藏列表中不存在的应用
     // 更新应用信息
-    for (ItemInfo_v1 &info : m_favoriteSortedList) {
-        if (info.m_key == "dde-trash") {
+    for (auto it = m_favoriteSortedList.begin(); it != m_favoriteSortedList.end();) {
+        if (it->m_key == "dde-trash") {
             // blumia: It's possible the icon is changed by appsmanager (the user-trash one).
             //         This is definitely not the correct approach.
             //         As a workaround, we also update the icon key here.
-            info.m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
+            it->m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
         }
 
-        if (!contains(m_allAppInfoList, info)) {
-            m_favoriteSortedList.removeOne(info);
+        const AppId id = installedAppId(*it);
+        if (id == AppInfoStore::InvalidId) {
+            it = m_favoriteSortedList.erase(it);
         } else {
-            int index = itemIndex(m_allAppInfoList, info);
-            info.updateInfo(m_allAppInfoList.at(index));
+            it->updateInfo(m_appStore.info(id));
+            ++it;
         }
     }
 
@@ -1713,35 +2202,34 @@ void AppsManager::updateTrashIconFromInfoList()
         }
     };
 
-    updateTrashIcon(m_allAppInfoList);
+    for (const AppId id : m_allAppIds) {
+        ItemInfo_v1 *info = m_appStore.record(id);
+        if (info && info->m_key == QLatin1String("dde-trash"))
+            info->m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
+    }
+
     updateTrashIcon(m_fullscreenUsedSortedList);
-    updateTrashIcon(m_windowedUsedSortedList);
     updateTrashIcon(m_favoriteSortedList);
 }
 
 void AppsManager::saveAppCategoryInfoList()
 {
     // 保存排序信息
-    QHash<AppsListModel::AppCategory, ItemInfoList_v1>::iterator categoryAppsIter = m_appInfos.begin();
+    QHash<AppsListModel::AppCategory, AppIdList>::iterator categoryAppsIter = m_appInfos.begin();
     for (; categoryAppsIter != m_appInfos.end(); ++categoryAppsIter) {
         int category = categoryAppsIter.key();
-        m_categorySetting->setValue(QString("lists_%1").arg(category), getCacheMapData(categoryAppsIter.value()));
+        m_categorySetting->setValue(QString("lists_%1").arg(category), getCacheMapData(m_appStore.infoList(categoryAppsIter.value())));
     }
 }
 
 void AppsManager::generateCategoryMap()
 {
-    for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        // 梳理应用分类数据, 为后续小窗口标题模式提供数据
-        const AppsListModel::AppCategory category = info.category();
-        if (!m_appInfos.contains(category))
-            m_appInfos.insert(category, ItemInfoList_v1());
-
-        const int idx = itemIndex(m_appInfos[category], info);
-        if (idx == -1)
-            m_appInfos[category].append(info);
-        else
-            m_appInfos[category][idx].updateInfo(info);
+    for (const AppId id : m_allAppIds) {
+        // 梳理应用分类数据, 为后续小窗口标题模式提供数据, 应用信息已在记录表中更新
+        const AppsListModel::AppCategory category = m_appStore.info(id).category();
+        AppIdList &categoryIds = m_appInfos[category];
+        if (!categoryIds.contains(id))
+            categoryIds.append(id);
     }
 
     getCategoryListAndSortCategoryId();
@@ -1757,11 +2245,12 @@ void AppsManager::generateTitleCategoryList()
     m_appCategoryInfos.clear();
     for (int i = 0; i < m_categoryList.size(); i++) {
         int categoryId = static_cast<int>(m_categoryList.at(i).m_categoryId + AppsListModel::Internet);
-        if (m_appInfos.value(AppsListModel::AppCategory(categoryId)).size() <= 0)
+        const AppIdList &categoryIds = m_appInfos.value(AppsListModel::AppCategory(categoryId));
+        if (categoryIds.size() <= 0)
             continue;
 
-        m_appCategoryInfos.append(m_categoryList.at(i));
-        m_appCategoryInfos.append(m_appInfos.value(AppsListModel::AppCategory(categoryId)));
+        m_appCategoryInfos.append(m_appStore.insert(m_categoryList.at(i)));
+        m_appCategoryInfos.append(categoryIds);
     }
 }
 
@@ -1771,15 +2260,19 @@ void AppsManager::generateTitleCategoryList()
 void AppsManager::generateLetterCategoryList()
 {
     // 字母排序
-    ItemInfoList_v1 letterSortList = m_allAppInfoList;
+    ItemInfoList_v1 letterSortList = m_appStore.infoList(m_allAppIds);
 
     // 先按照通用规则分类
     sortByGeneralOrder(letterSortList);
 
     // 按照大写字母表顺序对应用列表进行分组排序
     // 对每个分组的应用列表按照字母表顺序排序
+    // 应用已在记录表中, 字母标题作为新记录加入
     m_appLetterModeInfos.clear();
-    m_appLetterModeInfos = sortByLetterOrder(letterSortList);
+    const ItemInfoList_v1 letterGroupList = sortByLetterOrder(letterSortList);
+    m_appLetterModeInfos.reserve(letterGroupList.size());
+    for (const ItemInfo_v1 &info : letterGroupList)
+        m_appLetterModeInfos.append(m_appStore.insert(info));
 }
 
 void AppsManager::readCollectedCacheData()
@@ -1789,7 +2282,7 @@ void AppsManager::readCollectedCacheData()
 
     if (!QFile::exists(filePath)) {
         // 获取小窗口默认收藏列表
-        loadDefaultFavoriteList(m_allAppInfoList);
+        loadDefaultFavoriteList(m_appStore.infoList(m_allAppIds));
 
         // 缓存小窗口收藏列表
         saveCollectedSortedList();
@@ -1857,7 +2350,9 @@ void AppsManager::refreshAppAutoStartCache(const QString &type, const QString &d
             }
         }
 
-        emit dataChanged(AppsListModel::FullscreenAll);
+        notifyItemsUpdated([ & ](const ItemInfo_v1 &info) {
+            return info.m_desktop == desktpFilePath;
+        }, { AppsListModel::AppAutoStartRole });
     }
 }
 
@@ -1891,29 +2386,42 @@ void AppsManager::handleItemChanged(const QString &operation, const ItemInfo_v2
         if (fuzzyMatching(filters, info.m_key))
             return;
 
-        m_allAppInfoList.append(info);
-        m_fullscreenUsedSortedList.append(info);
-        m_windowedUsedSortedList.insert(0, info);
+        const AppId id = m_appStore.insert(info);
+        if (!m_allAppIds.contains(id))
+            m_allAppIds.append(id);
+        insertListItem(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList, m_fullscreenUsedSortedList.size(), info);
+        insertListItem(AppsListModel::WindowedAll, m_windowedUsedSortedList, 0, id);
     } else if (operation == "deleted") {
-        m_allAppInfoList.removeOne(info);
-        m_fullscreenUsedSortedList.removeOne(info);
+        // 记录在下次刷新时移除, 避免其他列表中的 id 失效
+        m_allAppIds.removeOne(m_appStore.find(info.m_desktop));
+        m_frecencyRanker.remove(info.m_desktop);
+        const int row = m_fullscreenUsedSortedList.indexOf(info);
+        if (row != -1)
+            removeListItem(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList, row);
     } else if (operation == "updated") {
-        Q_ASSERT(contains(m_allAppInfoList, info));
+        // 应用更新后图标文件可能被替换
+        removeIconCache(info.m_desktop);
 
         // 更新所有应用列表
-        int index = itemIndex(m_allAppInfoList, info);
-        if (index != -1)
-            m_allAppInfoList[index].updateInfo(info);
+        ItemInfo_v1 *record = m_appStore.record(m_appStore.find(info.m_desktop));
+        Q_ASSERT(record);
+        if (record)
+            record->updateInfo(info);
 
         // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_fullscreenUsedSortedList, info);
-        if (index != -1)
+        int index = itemIndex(m_fullscreenUsedSortedList, info);
+        if (index != -1) {
             m_fullscreenUsedSortedList[index].updateInfo(info);
+            emit itemsChanged(AppsListModel::FullscreenAll, AppsChange::updated(index, index));
+        }
 
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_windowedUsedSortedList, info);
+        // 小窗口列表中只保存记录 id, 记录已更新, 只需通知模型
+        index = m_windowedUsedSortedList.indexOf(m_appStore.find(info.m_desktop));
         if (index != -1)
-            m_windowedUsedSortedList[index].updateInfo(info);
+            emit itemsChanged(AppsListModel::WindowedAll, AppsChange::updated(index, index));
+
+        // 包含该应用的文件夹缩略图也需要重新合成
+        emit itemDataChanged(info);
     } else {
         qDebug() << "nonexistent condition, operation:" << operation;
         return;
@@ -1938,33 +2446,50 @@ void AppsManager::handleItemChanged(const QString &operation, const ItemInfo &ap
         if (fuzzyMatching(filters, info.m_key))
             return;
 
-        m_allAppInfoList.append(info);
-        m_fullscreenUsedSortedList.append(info);
-        m_windowedUsedSortedList.insert(0, info);
+        const AppId id = m_appStore.insert(info);
+        if (!m_allAppIds.contains(id))
+            m_allAppIds.append(id);
+        insertListItem(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList, m_fullscreenUsedSortedList.size(), info);
+        insertListItem(AppsListModel::WindowedAll, m_windowedUsedSortedList, 0, id);
     } else if (operation == "deleted") {
-        m_allAppInfoList.removeOne(info);
-        m_fullscreenUsedSortedList.removeOne(info);
-        m_windowedUsedSortedList.removeOne(info);
+        // 记录在下次刷新时移除, 避免其他列表中的 id 失效
+        m_allAppIds.removeOne(m_appStore.find(info.m_desktop));
+        m_frecencyRanker.remove(info.m_desktop);
+        int row = m_fullscreenUsedSortedList.indexOf(info);
+        if (row != -1)
+            removeListItem(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList, row);
+
+        row = m_windowedUsedSortedList.indexOf(m_appStore.find(info.m_desktop));
+        if (row != -1)
+            removeListItem(AppsListModel::WindowedAll, m_windowedUsedSortedList, row);
         //一般情况是不需要的，但是类似wps这样的程序有点特殊，删除一个其它的二进制程序也删除了，需要保存列表，否则刷新的时候会刷新出齿轮的图标
         //新增和更新则无必要
         saveFullscreenUsedSortedList();
         saveWidowedUsedSortedList();
     } else if (operation == "updated") {
-        Q_ASSERT(contains(m_allAppInfoList, info));
+        // 应用更新后图标文件可能被替换
+        removeIconCache(info.m_desktop);
+
         // 更新所有应用列表
-        int index = itemIndex(m_allAppInfoList, info);
-        if (index != -1)
-            m_allAppInfoList[index].updateInfo(info);
+        ItemInfo_v1 *record = m_appStore.record(m_appStore.find(info.m_desktop));
+        Q_ASSERT(record);
+        if (record)
+            record->updateInfo(info);
 
         // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_fullscreenUsedSortedList, info);
-        if (index != -1)
+        int index = itemIndex(m_fullscreenUsedSortedList, info);
+        if (index != -1) {
             m_fullscreenUsedSortedList[index].updateInfo(info);
+            emit itemsChanged(AppsListModel::FullscreenAll, AppsChange::updated(index, index));
+        }
 
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_windowedUsedSortedList, info);
+        // 小窗口列表中只保存记录 id, 记录已更新, 只需通知模型
+        index = m_windowedUsedSortedList.indexOf(m_appStore.find(info.m_desktop));
         if (index != -1)
-            m_windowedUsedSortedList[index].updateInfo(info);
+            emit itemsChanged(AppsListModel::WindowedAll, AppsChange::updated(index, index));
+
+        // 包含该应用的文件夹缩略图也需要重新合成
+        emit itemDataChanged(info);
     } else {
         qDebug() << "nonexistent condition, operation:" << operation;
         return;
@@ -2145,24 +2670,6 @@ void AppsManager::updateDrawerTitle(const QModelIndex &index,const QString &newT
     }
 }
 
-QList<QPixmap> AppsManager::getDirAppIcon(QModelIndex modelIndex)
-{
-    QList<QPixmap> pixmapList;
-    ItemInfoList_v1 infoList;
-    ItemInfo_v1 info = modelIndex.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
-
-    if (contains(m_fullscreenUsedSortedList, info) && info.m_isDir)
-        infoList.append(info.m_appInfoList);
-
-    for (int i = 0; i < infoList.size(); i++) {
-        ItemInfo_v1 itemInfo = infoList.at(i);
-        int category = static_cast<const AppsListModel *>(modelIndex.model())->category();
-        pixmapList << appIcon(itemInfo, m_calUtil->appIconSize(category).width());
-    }
-
-    return pixmapList;
-}
-
 void AppsManager::updateTrashState()
 {
     int trashItemsCount = m_trashMonitor->trashItemCount();
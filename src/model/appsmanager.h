@@ -6,6 +6,8 @@
 #define APPSMANAGER_H
 
 #include "appslistmodel.h"
+#include "appinfostore.h"
+#include "frecencyranker.h"
 #include "dbustartmanager.h"
 #include "calculate_util.h"
 #include "common.h"
@@ -18,6 +20,7 @@
 #include <DDialog>
 
 #include <QHash>
+#include <QSet>
 #include <QSettings>
 #include <QPixmap>
 #include <QTimer>
@@ -25,6 +28,9 @@
 #include <QDesktopWidget>
 #include <QScreen>
 #include <QList>
+#include <QFileSystemWatcher>
+
+#include <functional>
 
 DGUI_USE_NAMESPACE
 
@@ -54,9 +60,11 @@ public:
     void insertDropItem(int pos);
     void abandonStashedItem(const QString &desktop);
     void restoreItem(const QString &desktop, AppsListModel::AppCategory mode, const int pos = -1);
+    bool canMoveItem(AppsListModel::AppCategory mode, int from, int to);
+    bool moveItem(AppsListModel::AppCategory mode, int from, int to);
     int dockPosition() const;
     QRect dockGeometry() const;
-    bool isHaveNewInstall() const { return !m_newInstalledAppsList.isEmpty(); }
+    bool isHaveNewInstall() const { return !m_newInstalledApps.isEmpty(); }
     bool isVaild();
     void refreshAllList();
     int getPageCount(const AppsListModel::AppCategory category);
@@ -70,7 +78,6 @@ public:
 
     void updateUsedSortData(QModelIndex dragIndex, QModelIndex dropIndex);
     void updateDrawerTitle(const QModelIndex &index, const QString &newTitle = QString());
-    QList<QPixmap> getDirAppIcon(QModelIndex modelIndex);
     void showSearchedData(const AppInfoList &list);
     const ItemInfo_v1 getItemInfo(const QString &desktop);
     void dropToCollected(const ItemInfo_v1 &info, const int row);
@@ -118,10 +125,13 @@ public:
 signals:
     void itemDataChanged(const ItemInfo_v1 &info) const;
     void dataChanged(const AppsListModel::AppCategory category) const;
+    void itemsAboutToChange(const AppsListModel::AppCategory category, const AppsChange &change) const;
+    void itemsChanged(const AppsListModel::AppCategory category, const AppsChange &change) const;
     void requestTips(const QString &tips) const;
     void requestHideTips() const;
     void categoryListChanged() const;
     void IconSizeChanged() const;
+    void iconsChanged() const;
     void dockGeometryChanged() const;
 
     void itemRedraw(const QModelIndex &index);
@@ -142,24 +152,27 @@ public slots:
     void onMoveToFirstInCollected(const QModelIndex index);
     void setDirAppInfoList(const QModelIndex index);
     int appsInfoListSize(const AppsListModel::AppCategory &category);
+    QVector<int> itemIndexes(const AppsListModel::AppCategory category, const ItemInfo_v1 &info) const;
     const ItemInfoList_v1 appsInfoList(const AppsListModel::AppCategory &category) const;
     const ItemInfo_v1 appsInfoListIndex(const AppsListModel::AppCategory &category,const int index);
     const ItemInfo_v1 appsCategoryListIndex(const int index);
     const ItemInfo_v1 appsLetterListIndex(const int index);
     const ItemInfoList_v1 &windowedCategoryList();
-    const ItemInfoList_v1 &windowedFrameItemInfoList();
+    const AppIdList &windowedFrameItemInfoList();
     const ItemInfoList_v1 &fullscreenItemInfoList();
     const ItemInfo_v1 dirAppInfo(int index);
-    const QHash<AppsListModel::AppCategory, ItemInfoList_v1> &categoryList();
+    const QHash<AppsListModel::AppCategory, AppIdList> &categoryList();
 
     bool appIsNewInstall(const QString &key);
     bool appIsAutoStart(const QString &desktop);
     bool appIsOnDock(const QString &desktop);
+    bool appIsFavorite(const QString &desktop) const;
     bool appIsOnDesktop(const QString &desktop);
     bool appIsProxy(const QString &desktop);
     bool appIsEnableScaling(const QString &desktop);
     const QPixmap appIcon(const ItemInfo_v1 &info, const int size = 0);
     const QString appName(const ItemInfo_v1 &info, const int size);
+    const QString appDisplayName(const ItemInfo_v1 &info);
     int appNums(const AppsListModel::AppCategory &category);
 
     // 为顺应数据应用数据结构的变动以及兼容性考虑, 对　handleItemChanged 接口进行了重载．
@@ -174,16 +187,18 @@ public slots:
 private:
     explicit AppsManager(QObject *parent = nullptr);
 
-    void sortByPresetOrder(ItemInfoList_v1 &processList);
-    void sortByUseFrequence(ItemInfoList_v1 &processList);
+    void sortByPresetOrder(AppIdList &processList);
+    void sortByUseFrequence(AppIdList &processList);
     void loadDefaultFavoriteList(const ItemInfoList_v1 &processList);
     void sortByGeneralOrder(ItemInfoList_v1 &processList);
     ItemInfoList_v1 sortByLetterOrder(ItemInfoList_v1 &processList);
-    void sortByPinyinOrder(ItemInfoList_v1 &processList);
     void sortByInstallTimeOrder(ItemInfoList_v1 &processList);
     void updateDataFromAllAppList(ItemInfoList_v1 &processList);
     void removeNonexistentData();
     void removeDuplicateData(ItemInfoList_v1 &processList);
+    ItemInfoList_v1 *movableList(AppsListModel::AppCategory mode);
+    AppId installedAppId(const ItemInfo_v1 &item) const;
+    AppIdList installedAppIds(const ItemInfoList_v1 &cachedList);
     void getCategoryListAndSortCategoryId();
     void refreshCategoryInfoList();
     void refreshItemInfoList();
@@ -192,8 +207,18 @@ private:
     void generateCategoryMap();
     void generateTitleCategoryList();
     void generateLetterCategoryList();
+    void refreshNewInstalledApps();
+    void insertListItem(AppsListModel::AppCategory category, ItemInfoList_v1 &list, int row, const ItemInfo_v1 &info);
+    void removeListItem(AppsListModel::AppCategory category, ItemInfoList_v1 &list, int row);
+    void insertListItem(AppsListModel::AppCategory category, AppIdList &ids, int row, AppId id);
+    void removeListItem(AppsListModel::AppCategory category, AppIdList &ids, int row);
+    void notifyItemsUpdated(const std::function<bool(const ItemInfo_v1 &)> &match, const QVector<int> &roles);
+    void loadFrecencyData(const ItemInfoList_v1 &cachedList);
     void readCollectedCacheData();
     void refreshAppAutoStartCache(const QString &type = QString(), const QString &desktpFilePath = QString());
+    void addPendingIcon(const ItemInfo_v1 &info);
+    void removeIconCache(const QString &desktop);
+    void watchIconDirectories();
 
     void setAutostartValue(const QStringList &list);
     QStringList getAutostartValue() const;
@@ -202,29 +227,32 @@ private slots:
     void markLaunched(const QString &appKey);
     void delayRefreshData();
     void refreshIcon();
+    void clearIconCache();
+    void onIconDirectoryChanged(const QString &path);
     void updateTrashState();
     bool fuzzyMatching(const QStringList& list, const QString& key);
-    void onRefreshCalendarTimer();
     void onGSettingChanged(const QString & keyName);
 
 public:
-    QHash<AppsListModel::AppCategory, ItemInfoList_v1> m_appInfos;      // 应用分类容器
-    ItemInfoList_v1 m_appCategoryInfos;                                 // 小窗口左侧带分类标题的应用列表
-    ItemInfoList_v1 m_appLetterModeInfos;                               // 小窗口左侧字母排序模式列表
+    QHash<AppsListModel::AppCategory, AppIdList> m_appInfos;            // 应用分类容器
+    AppIdList m_appCategoryInfos;                                       // 小窗口左侧带分类标题的应用列表
+    AppIdList m_appLetterModeInfos;                                     // 小窗口左侧字母排序模式列表
     ItemInfoList_v1 m_favoriteSortedList;                               // 小窗口收藏列表
     ItemInfoList_v1 m_categoryList;                                     // 小窗口应用分类目录列表
-    ItemInfoList_v1 m_appSearchResultList;                              // 搜索结果列表
+    AppIdList m_appSearchResultList;                                    // 搜索结果列表
     ItemInfoList_v1 m_dirAppInfoList;                                   // 应用抽屉列表
-    ItemInfoList_v1 m_fullscreenUsedSortedList;                         // 全屏应用列表
-    ItemInfoList_v1 m_windowedUsedSortedList;                           // 小窗口应用列表
+    ItemInfoList_v1 m_fullscreenUsedSortedList;                         // 全屏应用列表, 包含文件夹及拖拽状态, 保存应用信息
+    AppIdList m_windowedUsedSortedList;                                 // 小窗口应用列表
 
 private:
     DBusStartManager *m_startManagerInter;
     AMDBusLauncherInter *m_amDbusLauncherInter;
     AMDBusDockInter *m_amDbusDockInter;
     QString m_searchText;
-    ItemInfoList_v1 m_allAppInfoList;                                       // 所有app信息列表
-    QStringList m_newInstalledAppsList;                                     // 新安装应用列表
+    AppInfoStore m_appStore;                                                // 应用及分类标题的信息记录
+    AppIdList m_allAppIds;                                                  // 所有app记录id列表
+    QSet<QString> m_newInstalledApps;                                       // 新安装应用集合, 元素为应用 key
+    FrecencyRanker m_frecencyRanker;                                        // 小窗口所有应用的使用频率排名
 
     ItemInfoList_v1 m_stashList;
     ItemInfo_v1 m_unInstallItem;
@@ -232,14 +260,10 @@ private:
 
     CalculateUtil *m_calUtil;
     QTimer *m_delayRefreshTimer;                                            // 延迟刷新应用列表定时器指针对象
-    QTimer *m_refreshCalendarIconTimer;
-
-    QDate m_curDate;
-    int m_lastShowDate;
 
-    int m_tryNums;                                                          // 获取应用图标时尝试的次数
-    int m_tryCount;                                                         // 超过10次停止遍历
-    ItemInfo_v1 m_itemInfo;                                                 // 当前需要更新的应用信息
+    QFileSystemWatcher *m_iconDirWatcher;                                   // 监听图标主题目录及 pixmaps 目录
+    QTimer *m_refreshIconTimer;                                             // 合并目录变化信号后再刷新图标
+    QHash<QString, ItemInfo_v1> m_pendingIconItems;                         // 未找到图标的应用, key 为 cacheKey
 
     static QPointer<AppsManager> INSTANCE;
     static QGSettings *m_launcherSettings;
@@ -262,7 +286,6 @@ private:
     bool m_trashIsEmpty;
     TrashMonitor *m_trashMonitor;
 
-    QTimer *m_updateCalendarTimer;
     bool m_uninstallDlgIsShown;
     DragMode m_dragMode;                                                    // 拖拽类型
     AppsListModel::AppCategory m_curCategory;                               // 当前视图列表的模式类型
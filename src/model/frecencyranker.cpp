@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "frecencyranker.h"
+
+#include <QtMath>
+
+#include <cmath>
+
+constexpr qint64 FrecencyRanker::DefaultHalfLife;
+
+FrecencyRanker::FrecencyRanker(qint64 halfLife)
+    : m_decayRate(M_LN2 / qMax<qint64>(halfLife, 1))
+{
+}
+
+/**
+ * @brief FrecencyRanker::recordLaunch 记录一次应用启动, 复杂度为 O(log n)
+ * @param desktop 应用 desktop 路径
+ * @param time 启动时间, 单位秒
+ */
+void FrecencyRanker::recordLaunch(const QString &desktop, qint64 time)
+{
+    if (desktop.isEmpty())
+        return;
+
+    // 当前分值为 exp(key - 衰减率 * time), 加 1 后再换算回键值
+    const double base = m_decayRate * time;
+    auto it = m_rankKeys.constFind(desktop);
+    if (it == m_rankKeys.constEnd()) {
+        setRankKey(desktop, base);
+        return;
+    }
+
+    setRankKey(desktop, base + std::log1p(std::exp(it.value() - base)));
+}
+
+/**
+ * @brief FrecencyRanker::seed 使用打开次数作为应用的初始分值, 用于兼容只记录了打开次数的历史缓存
+ * @param desktop 应用 desktop 路径
+ * @param openCount 打开次数
+ * @param time 分值对应的时间, 单位秒
+ */
+void FrecencyRanker::seed(const QString &desktop, qlonglong openCount, qint64 time)
+{
+    if (desktop.isEmpty() || openCount <= 0)
+        return;
+
+    setRankKey(desktop, std::log(static_cast<double>(openCount)) + m_decayRate * time);
+}
+
+void FrecencyRanker::remove(const QString &desktop)
+{
+    auto it = m_rankKeys.find(desktop);
+    if (it == m_rankKeys.end())
+        return;
+
+    m_rankEntries.erase(RankEntry(it.value(), desktop));
+    m_rankKeys.erase(it);
+}
+
+void FrecencyRanker::clear()
+{
+    m_rankEntries.clear();
+    m_rankKeys.clear();
+}
+
+bool FrecencyRanker::contains(const QString &desktop) const
+{
+    return m_rankKeys.contains(desktop);
+}
+
+/**
+ * @brief FrecencyRanker::score 获取应用在指定时间的分值
+ * @param desktop 应用 desktop 路径
+ * @param time 时间, 单位秒
+ * @return 应用的分值, 未启动过的应用为 0
+ */
+double FrecencyRanker::score(const QString &desktop, qint64 time) const
+{
+    auto it = m_rankKeys.constFind(desktop);
+    if (it == m_rankKeys.constEnd())
+        return 0;
+
+    return std::exp(it.value() - m_decayRate * time);
+}
+
+/**
+ * @brief FrecencyRanker::topApps 获取排名靠前的应用
+ * @param count 获取的数量, 小于 0 时返回所有应用
+ * @return 按排名排列的应用 desktop 路径列表
+ */
+QStringList FrecencyRanker::topApps(int count) const
+{
+    if (count < 0 || count > size())
+        count = size();
+
+    QStringList desktops;
+    desktops.reserve(count);
+    for (auto it = m_rankEntries.cbegin(); it != m_rankEntries.cend() && desktops.size() < count; ++it)
+        desktops.append(it->second);
+
+    return desktops;
+}
+
+/**
+ * @brief FrecencyRanker::toVariantMap 导出排名数据用于缓存, 每个应用只保存一个排序键值
+ * @return desktop 路径与排序键值
+ */
+QVariantMap FrecencyRanker::toVariantMap() const
+{
+    QVariantMap map;
+    for (auto it = m_rankKeys.cbegin(); it != m_rankKeys.cend(); ++it)
+        map.insert(it.key(), it.value());
+
+    return map;
+}
+
+void FrecencyRanker::fromVariantMap(const QVariantMap &map)
+{
+    clear();
+
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        bool ok = false;
+        const double rankKey = it.value().toDouble(&ok);
+        if (ok && std::isfinite(rankKey))
+            setRankKey(it.key(), rankKey);
+    }
+}
+
+void FrecencyRanker::setRankKey(const QString &desktop, double rankKey)
+{
+    auto it = m_rankKeys.find(desktop);
+    if (it != m_rankKeys.end()) {
+        m_rankEntries.erase(RankEntry(it.value(), desktop));
+        it.value() = rankKey;
+    } else {
+        m_rankKeys.insert(desktop, rankKey);
+    }
+
+    m_rankEntries.insert(RankEntry(rankKey, desktop));
+}
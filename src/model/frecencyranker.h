@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FRECENCYRANKER_H
+#define FRECENCYRANKER_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <set>
+#include <utility>
+
+/**
+ * @brief The FrecencyRanker class 应用使用频率排名
+ * 每次启动应用计 1 分, 分值随时间按半衰期衰减, 兼顾使用次数与最近使用时间.
+ * 所有应用的分值以相同的速率衰减, 排名不随时间变化, 因此只保存换算到同一时间基准的
+ * 排序键值 key = ln(分值) + 衰减率 * 最近启动时间, 启动应用时只需更新一条记录
+ */
+class FrecencyRanker
+{
+public:
+    static constexpr qint64 DefaultHalfLife = 7 * 24 * 3600;       // 默认半衰期为 7 天, 单位秒
+
+    explicit FrecencyRanker(qint64 halfLife = DefaultHalfLife);
+
+    void recordLaunch(const QString &desktop, qint64 time);
+    void seed(const QString &desktop, qlonglong openCount, qint64 time);
+    void remove(const QString &desktop);
+    void clear();
+
+    bool contains(const QString &desktop) const;
+    double score(const QString &desktop, qint64 time) const;
+    QStringList topApps(int count) const;
+    int size() const { return m_rankKeys.size(); }
+
+    QVariantMap toVariantMap() const;
+    void fromVariantMap(const QVariantMap &map);
+
+private:
+    void setRankKey(const QString &desktop, double rankKey);
+
+private:
+    typedef std::pair<double, QString> RankEntry;
+
+    struct RankEntryCompare {
+        bool operator()(const RankEntry &entry1, const RankEntry &entry2) const
+        {
+            // 键值大的排在前面, 键值相同时按 desktop 路径排列, 保证顺序稳定
+            if (entry1.first != entry2.first)
+                return entry1.first > entry2.first;
+
+            return entry1.second < entry2.second;
+        }
+    };
+
+    double m_decayRate;                                         // 每秒的衰减率, ln2 / 半衰期
+    std::set<RankEntry, RankEntryCompare> m_rankEntries;        // 按排名排列的应用
+    QHash<QString, double> m_rankKeys;                          // desktop 路径与排序键值
+};
+
+#endif // FRECENCYRANKER_H
@@ -9,6 +9,7 @@
 #include "appslistmodel.h"
 #include "fullscreenframe.h"
 #include "windowedframe.h"
+#include "floatitemwidget.h"
 
 #include <DGuiApplicationHelper>
 
@@ -20,10 +21,10 @@
 #include <QtGlobal>
 #include <QDrag>
 #include <QPropertyAnimation>
+#include <QParallelAnimationGroup>
 #include <QLabel>
 #include <QPainter>
 #include <QScrollBar>
-#include <QVBoxLayout>
 #include <QSortFilterProxyModel>
 
 DGUI_USE_NAMESPACE
@@ -40,11 +41,6 @@ AppGridView::AppGridView(const ViewType viewType, QWidget *parent)
     , m_calcUtil(CalculateUtil::instance())
     , m_longPressed(false)
     , m_pixLabel(nullptr)
-    , m_calendarWidget(nullptr)
-    , m_vlayout(nullptr)
-    , m_monthLabel(nullptr)
-    , m_dayLabel(nullptr)
-    , m_weekLabel(nullptr)
     , m_viewType(viewType)
 {
     initUi();
@@ -198,7 +194,7 @@ void AppGridView::dragEnterEvent(QDragEnterEvent *e)
     const ItemInfo_v1 &info = m_appManager->getItemInfo(e->mimeData()->data("DesktopPath"));
     // 从其他视图列表中拖入重复的数据直接返回，避免总有一个item正在拖拽中的状态导致没有绘制的问题
     if (listModel && listModel->category() == AppsListModel::Favorite && dragIndex.model() && dragIndex.model() != listModel) {
-        if (m_appManager->contains(m_appManager->appsInfoList(AppsListModel::Favorite), info) ) {
+        if (m_appManager->appIsFavorite(info.m_desktop)) {
             qDebug() << "repeated data...";
             return;
         }
@@ -425,65 +421,14 @@ void AppGridView::mouseReleaseEvent(QMouseEvent *e)
 
 QPixmap AppGridView::creatSrcPix(const QModelIndex &index)
 {
-    QPixmap srcPix;
-
     const QString &desktop = index.data(AppsListModel::AppDesktopRole).toString();
     if (desktop.contains("/dde-calendar.desktop")) {
-#ifdef QT_DEBUG
-        qInfo() << "category: " << static_cast<AppsListModel *>(model())->category();
-#endif
+        // 与列表中绘制的日历图标共用同一份缓存
         const auto itemSize = m_calcUtil->appIconSize(static_cast<AppsListModel *>(model())->category());
-        const double iconZoom =  itemSize.width() / 64.0;
-        QStringList calIconList = m_calcUtil->calendarSelectIcon();
-
-        m_calendarWidget->setFixedSize(itemSize);
-        m_calendarWidget->setAutoFillBackground(true);
-        QPalette palette = m_calendarWidget->palette();
-        palette.setBrush(QPalette::Window,
-                         QBrush(QPixmap(calIconList.at(0)).scaled(
-                                    m_calendarWidget->size(),
-                                    Qt::IgnoreAspectRatio,
-                                    Qt::SmoothTransformation)));
-        m_calendarWidget->setPalette(palette);
-
-        m_vlayout->setSpacing(0);
-        auto monthPix = loadSvg(calIconList.at(1), QSize(20, 10) * iconZoom);
-        m_monthLabel->setPixmap(monthPix.scaled(monthPix.width(), monthPix.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        m_monthLabel->setFixedHeight(monthPix.height());
-        m_monthLabel->setAlignment(Qt::AlignCenter);
-        m_monthLabel->setFixedWidth(itemSize.width() - 5 * iconZoom);
-        m_monthLabel->show();
-        m_vlayout->addWidget(m_monthLabel, Qt::AlignVCenter);
-
-        auto dayPix = loadSvg(calIconList.at(2), QSize(28, 26) * iconZoom);
-        m_dayLabel->setPixmap(dayPix.scaled(dayPix.width(), dayPix.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        m_dayLabel->setAlignment(Qt::AlignCenter);
-        m_dayLabel->setFixedHeight(m_dayLabel->pixmap()->height());
-        m_dayLabel->raise();
-        m_dayLabel->show();
-        m_vlayout->addWidget(m_dayLabel, Qt::AlignVCenter);
-
-        auto weekPix = loadSvg(calIconList.at(3), QSize(14, 6) * iconZoom);
-        m_weekLabel->setPixmap(weekPix.scaled(weekPix.width(), weekPix.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        m_weekLabel->setFixedHeight(m_weekLabel->pixmap()->height());
-        m_weekLabel->setAlignment(Qt::AlignCenter);
-        m_weekLabel->setFixedWidth(itemSize.width() + 5 * iconZoom);
-        m_weekLabel->show();
-
-        m_vlayout->addWidget(m_weekLabel, Qt::AlignVCenter);
-        m_vlayout->setSpacing(0);
-        m_vlayout->setContentsMargins(0, 10 * iconZoom, 0, 10 * iconZoom);
-        m_calendarWidget->setLayout(m_vlayout);
-        m_calendarWidget->show();
-
-        srcPix = m_calendarWidget->grab(m_calendarWidget->rect());
-        m_calendarWidget->hide();
-        m_calendarWidget->setLayout(nullptr);
-    } else {
-        return index.data(AppsListModel::AppDragIconRole).value<QPixmap>();
+        return calendarIcon(itemSize.width(), qApp->devicePixelRatio());
     }
 
-    return srcPix;
+    return index.data(AppsListModel::AppDragIconRole).value<QPixmap>();
 }
 
 /**
@@ -534,6 +479,10 @@ void AppGridView::startDrag(const QModelIndex &index, bool execDrag)
         return;
     }
 
+    // 上一次拖拽的交换动画尚未结束时先完成交换, 拖拽状态只属于本次拖拽
+    finishFakeAnimation();
+    m_clearDraggingAfterAni = false;
+
     m_appManager->setDragModelIndex(index);
     setViewMoveState();
 
@@ -605,12 +554,13 @@ void AppGridView::startDrag(const QModelIndex &index, bool execDrag)
 
             listModel->clearDraggingIndex();
         } else {
-            connect(m_lastFakeAni, &QPropertyAnimation::finished, listModel, &AppsListModel::clearDraggingIndex);
+            // 交换动画结束后在 dropSwap 中清除
+            m_clearDraggingAfterAni = true;
         }
 
+        // 交换动画仍在执行时保留 m_lastFakeAni, 由 dropSwap 清除, 避免新的拖拽打断交换
         setDropAndLastPos(QPoint(0, 0));
         m_enableDropInside = false;
-        m_lastFakeAni = nullptr;
     });
 
     m_dropToPos = index.row();
@@ -741,11 +691,23 @@ void AppGridView::prepareDropSwap()
     if (start == end)
         return;
 
+    // 回收上一次使用的动画, 所有移动的应用由同一个动画组驱动
+    finishFakeAnimation();
+    while (m_fakeAniGroup->animationCount() > 0)
+        m_fakeAniGroup->takeAnimation(0)->setParent(this);
+
+    for (FloatItemWidget *floatLabel : m_floatLabels)
+        floatLabel->hide();
+
     int index = 0;
-    for (int i = (start + moveToNext); i != (end - !moveToNext); ++i)
+    const int last = end - !moveToNext;
+    for (int i = (start + moveToNext); i <= last; ++i)
         createFakeAnimation(i, moveToNext, index++);
 
-    createFakeAnimation(end - !moveToNext, moveToNext, index++, true);
+    if (m_fakeAniGroup->animationCount() > 0) {
+        m_lastFakeAni = m_fakeAniGroup;
+        m_fakeAniGroup->start();
+    }
 
     // item最后回归的位置
     setDropAndLastPos(appIconRect(dropIndex).topLeft());
@@ -757,9 +719,8 @@ void AppGridView::prepareDropSwap()
  * @brief AppGridView::createFakeAnimation 创建列表中item移动的动画效果
  * @param pos 需要移动的item当前所在的行数
  * @param moveNext item是否移动的标识
- * @param isLastAni 是最后的那个item移动的动画标识
  */
-void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const int rIndex, const bool isLastAni)
+void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const int rIndex)
 {
     if (rIndex >= m_floatLabels.size())
         return;
@@ -767,25 +728,10 @@ void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const
     // listview n行1列,肉眼所及的都是app自动换行后的效果
     const QModelIndex index(indexAt(pos));
 
-    QLabel *floatLabel = m_floatLabels[rIndex];
-    QPropertyAnimation *ani = new QPropertyAnimation(floatLabel, "pos", floatLabel);
-
-    const auto ratio = devicePixelRatioF();
-    const QSize rectSize = index.data(AppsListModel::ItemSizeHintRole).toSize();
+    FloatItemWidget *floatLabel = m_floatLabels[rIndex];
+    QPropertyAnimation *ani = m_fakeAnimations[rIndex];
 
-    QPixmap pixmap(rectSize * ratio);
-    pixmap.fill(Qt::transparent);
-    pixmap.setDevicePixelRatio(ratio);
-
-    QStyleOptionViewItem item;
-    item.rect = QRect(QPoint(0, 0), rectSize);
-    item.features |= QStyleOptionViewItem::HasDisplay;
-
-    QPainter painter(&pixmap);
-    itemDelegate()->paint(&painter, item, index);
-
-    floatLabel->setFixedSize(rectSize);
-    floatLabel->setPixmap(pixmap);
+    floatLabel->setIndex(index, index.data(AppsListModel::ItemSizeHintRole).toSize());
     floatLabel->show();
 
     if (m_calcUtil->fullscreen()) {
@@ -798,7 +744,6 @@ void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const
         ani->setEndValue(indexRect(indexAt(moveNext ? pos - 1 : pos + 1)).topLeft());
     }
 
-
     // InOutQuad 描述起点矩形到终点矩形的速度曲线
     ani->setEasingCurve(QEasingCurve::Linear);
     ani->setDuration(DLauncher::APP_DRAG_MININUM_TIME);
@@ -808,14 +753,7 @@ void AppGridView::createFakeAnimation(const int pos, const bool moveNext, const
         ani->setDuration(0);
     }
 
-    connect(ani, &QPropertyAnimation::finished, floatLabel, &QLabel::hide);
-    if (isLastAni) {
-        m_lastFakeAni = ani;
-        connect(ani, &QPropertyAnimation::finished, this, &AppGridView::dropSwap);
-        connect(ani, &QPropertyAnimation::valueChanged, m_dropThresholdTimer, &QTimer::stop);
-    }
-
-    ani->start(QPropertyAnimation::DeleteWhenStopped);
+    m_fakeAniGroup->addAnimation(ani);
 }
 
 /**
@@ -831,9 +769,27 @@ void AppGridView::dropSwap()
     listModel->dropSwap(m_dropToPos);
     m_lastFakeAni = nullptr;
 
+    if (m_clearDraggingAfterAni) {
+        m_clearDraggingAfterAni = false;
+        listModel->clearDraggingIndex();
+    }
+
     setState(NoState);
 }
 
+/**
+ * @brief AppGridView::finishFakeAnimation 立即结束正在执行的交换动画并完成交换,
+ * QAbstractAnimation::stop 不会发出 finished 信号, 需要手动调用 dropSwap
+ */
+void AppGridView::finishFakeAnimation()
+{
+    if (!m_fakeAniGroup || m_fakeAniGroup->state() == QAbstractAnimation::Stopped)
+        return;
+
+    m_fakeAniGroup->stop();
+    dropSwap();
+}
+
 const QRect AppGridView::indexRect(const QModelIndex &index) const
 {
     return rectForIndex(index);
@@ -871,38 +827,24 @@ void AppGridView::createMovingComponent()
         m_pixLabel->hide();
     }
 
-    // 拖拽过程中位置交换时显示的应用图标
+    // 拖拽过程中位置交换时显示的应用图标及其动画, 每次交换时重复使用
+    if (!m_fakeAniGroup) {
+        m_fakeAniGroup = new QParallelAnimationGroup(this);
+        connect(m_fakeAniGroup, &QParallelAnimationGroup::finished, this, &AppGridView::dropSwap);
+    }
+
     if (!m_floatLabels.size()) {
         // 单页最多28个应用
         for (int i = 0; i < m_calcUtil->appPageItemCount(AppsListModel::FullscreenAll); i++) {
-            QLabel *moveLabel = new QLabel(this);
+            FloatItemWidget *moveLabel = new FloatItemWidget(this, this);
             moveLabel->hide();
             m_floatLabels << moveLabel;
-        }
-    }
-
-    if (!m_calendarWidget) {
-        m_calendarWidget = new QWidget(this);
-        m_calendarWidget->hide();
-    }
-
-    if (!m_vlayout) {
-        m_vlayout = new QVBoxLayout(this);
-    }
-
-    if (!m_monthLabel) {
-        m_monthLabel = new QLabel(this);
-        m_monthLabel->hide();
-    }
-
-    if (!m_dayLabel) {
-        m_dayLabel = new QLabel(this);
-        m_dayLabel->hide();
-    }
 
-    if (!m_weekLabel) {
-        m_weekLabel = new QLabel(this);
-        m_weekLabel->hide();
+            QPropertyAnimation *ani = new QPropertyAnimation(moveLabel, "pos", this);
+            connect(ani, &QPropertyAnimation::finished, moveLabel, &QWidget::hide);
+            connect(ani, &QPropertyAnimation::valueChanged, m_dropThresholdTimer, &QTimer::stop);
+            m_fakeAnimations << ani;
+        }
     }
 }
 
@@ -919,6 +861,8 @@ void AppGridView::initConnection()
     connect(m_gestureInter, &Gesture::TouchUpOrCancel, this, &AppGridView::onTouchUpOrDown, Qt::UniqueConnection);
     connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppGridView::onLayoutChanged);
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &AppGridView::onThemeChanged);
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppGridView::invalidateSnapshot);
+    connect(qApp, &QGuiApplication::fontChanged, this, &AppGridView::invalidateSnapshot);
 }
 
 void AppGridView::initUi()
@@ -1001,5 +945,101 @@ void AppGridView::onTouchUpOrDown(double scalex, double scaley)
 
 void AppGridView::onThemeChanged(DGuiApplicationHelper::ColorType)
 {
+    invalidateSnapshot();
     update();
 }
+
+/**
+ * @brief AppGridView::setModel 设置模型, 模型数据变化时预先渲染的内容失效
+ * @param model 视图模型
+ */
+void AppGridView::setModel(QAbstractItemModel *model)
+{
+    QListView::setModel(model);
+    invalidateSnapshot();
+
+    if (!model)
+        return;
+
+    connect(model, &QAbstractItemModel::dataChanged, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+    connect(model, &QAbstractItemModel::modelReset, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+    connect(model, &QAbstractItemModel::rowsMoved, this, &AppGridView::invalidateSnapshot, Qt::UniqueConnection);
+}
+
+/**
+ * @brief AppGridView::updateSnapshot 将视图内容渲染到图片中, 内容未变化时不重复渲染
+ * @param force 是否强制重新渲染(当前页可能有悬停等状态变化)
+ */
+void AppGridView::updateSnapshot(bool force)
+{
+    const QSize snapshotSize = viewport()->size() * viewport()->devicePixelRatioF();
+    if (!force && !m_snapshotDirty && m_snapshot.size() == snapshotSize)
+        return;
+
+    // 渲染时需要实时绘制视图内容, 视图背景透明, 不绘制窗口背景
+    QPixmap snapshot(snapshotSize);
+    snapshot.setDevicePixelRatio(viewport()->devicePixelRatioF());
+    snapshot.fill(Qt::transparent);
+
+    const bool enabled = m_snapshotEnabled;
+    m_snapshotEnabled = false;
+    m_renderingSnapshot = true;
+    viewport()->render(&snapshot, QPoint(), QRegion(), QWidget::DrawChildren);
+    m_renderingSnapshot = false;
+    m_snapshotEnabled = enabled;
+
+    m_snapshot = snapshot;
+    m_snapshotDirty = false;
+}
+
+/**
+ * @brief AppGridView::setSnapshotEnabled 翻页动画过程中使用预先渲染的内容绘制, 结束后恢复实时绘制
+ * @param enabled 是否使用预先渲染的内容
+ */
+void AppGridView::setSnapshotEnabled(bool enabled)
+{
+    if (m_snapshotEnabled == enabled)
+        return;
+
+    m_snapshotEnabled = enabled;
+    viewport()->update();
+}
+
+void AppGridView::clearSnapshot()
+{
+    m_snapshot = QPixmap();
+    m_snapshotDirty = true;
+    m_snapshotEnabled = false;
+}
+
+void AppGridView::invalidateSnapshot()
+{
+    m_snapshotDirty = true;
+}
+
+void AppGridView::paintEvent(QPaintEvent *e)
+{
+    // 重绘统计: 设置 DDE_LAUNCHER_TRACE_REPAINT 环境变量时输出每一帧的重绘区域, 也可以连接 frameRepainted 信号统计
+    // 渲染翻页预览内容不是屏幕上的重绘, 不计入统计
+    static const bool traceRepaint = qEnvironmentVariableIsSet("DDE_LAUNCHER_TRACE_REPAINT");
+    if (!m_renderingSnapshot) {
+        ++m_repaintFrames;
+        if (traceRepaint)
+            qDebug() << "repaint" << this << "frame:" << m_repaintFrames << "damage:" << e->region().boundingRect()
+                     << "full viewport:" << (e->region().boundingRect() == viewport()->rect());
+
+        emit frameRepainted(e->region(), m_repaintFrames);
+    }
+
+    // 预先渲染的内容与视图大小一致时直接绘制, 避免动画过程中逐个绘制应用
+    if (m_snapshotEnabled && !m_snapshotDirty && m_snapshot.size() == viewport()->size() * viewport()->devicePixelRatioF()) {
+        QPainter painter(viewport());
+        painter.drawPixmap(0, 0, m_snapshot);
+        return;
+    }
+
+    QListView::paintEvent(e);
+}
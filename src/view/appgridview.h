@@ -26,7 +26,9 @@ public:
 class CalculateUtil;
 class AppsListModel;
 class FullScreenFrame;
-class QVBoxLayout;
+class FloatItemWidget;
+class QAbstractAnimation;
+class QParallelAnimationGroup;
 
 class AppGridView : public QListView
 {
@@ -64,6 +66,12 @@ public:
     void setViewMoveState(bool moving = false);
     bool getViewMoveState() const;
 
+    void setModel(QAbstractItemModel *model) override;
+
+    void updateSnapshot(bool force = false);
+    void setSnapshotEnabled(bool enabled);
+    void clearSnapshot();
+
 private:
     void createMovingComponent();
     void initConnection();
@@ -77,6 +85,7 @@ private slots:
     void onTouchSinglePresse(int time, double scalex, double scaley);
     void onTouchUpOrDown(double scalex, double scaley);
     void onThemeChanged(DGuiApplicationHelper::ColorType);
+    void invalidateSnapshot();
 
 signals:
     void popupMenuRequested(const QPoint &pos, const QModelIndex &index) const;
@@ -87,6 +96,7 @@ signals:
     void requestScrollRight(const QModelIndex &index) const;
     void dragEnd();
     void requestMouseRelease() const;
+    void frameRepainted(const QRegion &damage, quint64 frame) const;
 
 protected:
     void startDrag(const QModelIndex &index, bool execDrag = true);
@@ -97,12 +107,14 @@ protected:
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
     void mouseReleaseEvent(QMouseEvent *e) override;
+    void paintEvent(QPaintEvent *e) override;
 
 private slots:
     void dropSwap();
     void fitToContent();
     void prepareDropSwap();
-    void createFakeAnimation(const int pos, const bool moveNext, const int rIndex, const bool isLastAni = false);
+    void finishFakeAnimation();
+    void createFakeAnimation(const int pos, const bool moveNext, const int rIndex);
 
 private:
     int m_dropToPos;
@@ -112,7 +124,9 @@ private:
 
     const QWidget *m_containerBox = nullptr;
     QTimer *m_dropThresholdTimer;                        // 推拽过程中app交互动画定时器对象
-    QPropertyAnimation *m_lastFakeAni = nullptr;         // 推拽过程中app交换动画对象
+    QAbstractAnimation *m_lastFakeAni = nullptr;         // 推拽过程中app交换动画对象, 执行中时指向 m_fakeAniGroup
+    QParallelAnimationGroup *m_fakeAniGroup = nullptr;   // 统一驱动所有交换位置的应用动画
+    bool m_clearDraggingAfterAni = false;                // 交换动画结束后清除拖拽状态
     Gesture *m_gestureInter;
     DragPageDelegate *m_pDelegate;
 
@@ -125,15 +139,17 @@ private:
     QPoint m_dragStartPos;                               // 拖拽起点坐标
 
     QScopedPointer<QLabel> m_pixLabel;
-    QList<QLabel *> m_floatLabels;
+    QList<FloatItemWidget *> m_floatLabels;               // 预先创建的交换位置时移动的应用图标
+    QList<QPropertyAnimation *> m_fakeAnimations;        // 与 m_floatLabels 一一对应的动画, 重复使用
 
-    QWidget *m_calendarWidget;
-    QVBoxLayout *m_vlayout;
-    QLabel *m_monthLabel;
-    QLabel *m_dayLabel;
-    QLabel *m_weekLabel;
     ViewType m_viewType;
     QString m_appKey;
+
+    QPixmap m_snapshot;                                  // 预先渲染的视图内容, 翻页动画过程中代替实时绘制
+    bool m_snapshotDirty = true;                         // 视图内容变化后需要重新渲染
+    bool m_snapshotEnabled = false;                      // 是否使用预先渲染的内容绘制
+    bool m_renderingSnapshot = false;                    // 正在渲染翻页预览内容, 不计入重绘统计
+    quint64 m_repaintFrames = 0;                         // 视图重绘的次数
 };
 
 typedef QList<AppGridView *> AppGridViewList;
@@ -8,11 +8,18 @@
 #include "editlabel.h"
 
 #include <QHBoxLayout>
+#include <QTimer>
 
 #include <DGuiApplicationHelper>
 
 DGUI_USE_NAMESPACE
 
+// 当前页左右两侧保持实例化的分页数量
+static const int VISIBLE_PAGE_RANGE = 1;
+
+// 翻页结束后等待一段时间再预先渲染相邻分页
+static const int PRERENDER_DELAY = 300;
+
 /**
  * @brief MultiPagesView::MultiPagesView 全屏模式下多页列表控件类
  * @param categoryModel 应用分类类型
@@ -25,7 +32,10 @@ MultiPagesView::MultiPagesView(AppsListModel::AppCategory categoryModel, QWidget
     , m_appsManager(AppsManager::instance())
     , m_calcUtil(CalculateUtil::instance())
     , m_appListArea(new AppListArea)
-    , m_viewBox(new DHBoxWidget)
+    , m_viewType(categoryModel == AppsListModel::Dir ? AppGridView::PopupView : AppGridView::MainView)
+    , m_viewBox(new QWidget)
+    , m_prerenderTimer(new QTimer(this))
+    , m_pageSnapshotEnabled(false)
     , m_delegate(Q_NULLPTR)
     , m_titleLabel(new EditLabel(this))
     , m_pageControl(new PageControl)
@@ -33,6 +43,7 @@ MultiPagesView::MultiPagesView(AppsListModel::AppCategory categoryModel, QWidget
     , m_pageCount(0)
     , m_pageIndex(0)
     , m_bDragStart(false)
+    , m_dragging(false)
     , m_bMousePress(false)
     , m_nMousePos(0)
     , m_scrollValue(0)
@@ -63,6 +74,9 @@ MultiPagesView::MultiPagesView(AppsListModel::AppCategory categoryModel, QWidget
         m_pageSwitchAnimation->setDuration(0);
     }
 
+    m_prerenderTimer->setSingleShot(true);
+    m_prerenderTimer->setInterval(PRERENDER_DELAY);
+
     initUi();
     initConnection();
 }
@@ -81,46 +95,6 @@ void MultiPagesView::refreshTitle(const QString &title, int maxWidth)
     m_titleLabel->setVisible(true);
 }
 
-/**
- * @brief MultiPagesView::updateGradient 切换分页时屏幕左右两边30pixel的过渡效果
- * @param pixmap 屏幕背景图片对象
- * @param topLeftImg 左侧过渡范围起点
- * @param topRightImg 右侧过渡范围起点
- */
-void MultiPagesView::updateGradient(QPixmap &pixmap, QPoint topLeftImg, QPoint topRightImg)
-{
-    m_pLeftGradient->setDirection(GradientLabel::LeftToRight);
-    m_pRightGradient->setDirection(GradientLabel::RightToLeft);
-
-    const qreal ratio = devicePixelRatioF();
-    pixmap.setDevicePixelRatio(1);
-
-    int nWidth = DLauncher::TOP_BOTTOM_GRADIENT_HEIGHT * m_calcUtil->getScreenScaleX();
-    QSize gradientSize(nWidth, height());
-
-    QPoint topLeft = mapTo(this, QPoint(0, 0));
-    QRect topRect(topLeftImg * ratio, gradientSize * ratio);
-    QPixmap topCache = pixmap.copy(topRect);
-    topCache.setDevicePixelRatio(ratio);
-
-    m_pLeftGradient->setPixmap(topCache);
-    m_pLeftGradient->resize(gradientSize);
-    m_pLeftGradient->move(topLeft);
-    m_pLeftGradient->raise();
-
-    QPoint topRight(topLeft.x() + width() - gradientSize.width(), topLeft.y());
-    QPoint imgTopRight(topRightImg.x() - gradientSize.width(), topRightImg.y());
-
-    QRect RightRect(imgTopRight * ratio, gradientSize * ratio);
-    QPixmap bottomCache = pixmap.copy(RightRect);
-
-    m_pRightGradient->setPixmap(bottomCache);
-    m_pRightGradient->resize(gradientSize);
-    m_pRightGradient->move(topRight);
-    m_pRightGradient->raise();
-    setGradientVisible(true);
-}
-
 /**
  * @brief MultiPagesView::updatePageCount 更新分页控件信息
  * @param category 应用分类类型
@@ -138,59 +112,10 @@ void MultiPagesView::updatePageCount(AppsListModel::AppCategory category)
     if (pageCount == m_pageCount)
         return;
 
-    if (pageCount > m_pageCount) {
-        while (pageCount > m_pageCount) {
-            AppsListModel *pModel = new AppsListModel(m_category);
-            pModel->setPageIndex(m_pageCount);
-            m_pageAppsModelList.push_back(pModel);
-
-            AppGridView *pageView = Q_NULLPTR;
-            if (category == AppsListModel::FullscreenAll) {
-                pageView = new AppGridView(AppGridView::MainView, this);
-            } else {
-                // m_category == AppsListModel::Dir的时候
-                pageView = new AppGridView(AppGridView::PopupView, this);
-            }
-
-            pageView->setModel(pModel);
-            pageView->setItemDelegate(m_delegate);
-            pageView->setContainerBox(m_appListArea);
-            pageView->installEventFilter(this);
-            pageView->setDelegate(this);
-            m_appGridViewList.push_back(pageView);
-
-            m_viewBox->layout()->insertWidget(m_pageCount, pageView);
-
-            m_pageCount++;
-
-            connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
-            connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
-            connect(pageView, &AppGridView::requestScrollStop, [this] {
-                m_bDragStart = false;
-                setGradientVisible(false);
-            });
-            connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,pageView,&AppGridView::setDragAnimationEnable);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,this, [ = ] {
-                    setGradientVisible(false);
-            });
-            emit connectViewEvent(pageView);
-            // 新增的页面需要设置一下大小
-            updatePosition();
-        }
-    } else {
-        while (pageCount < m_pageCount) {
-            AppGridView *pageView = qobject_cast<AppGridView *>(m_viewBox->layout()->itemAt(m_pageCount - 1)->widget());
-            m_viewBox->layout()->removeWidget(pageView);
-            pageView->model()->deleteLater();
-            pageView->deleteLater();
-
-            m_pageAppsModelList.removeLast();
-            m_appGridViewList.removeLast();
-
-            m_pageCount--;
-        }
-    }
+    // 只实例化当前页及相邻页, 超出范围的视图回收复用
+    m_pageCount = pageCount;
+    recycleHiddenPages();
+    ensureVisiblePages();
 
     m_pageControl->setPageCount(m_pageCount > 1 ? pageCount : 0);
 }
@@ -208,17 +133,19 @@ void MultiPagesView::dragToLeft(const QModelIndex &index)
     if (isScrolling() || m_bDragStart)
         return;
 
-    m_appGridViewList[m_pageIndex]->dragOut(-1);
+    m_dragging = true;
+    pageView(m_pageIndex)->dragOut(-1);
 
     showCurrentPage(m_pageIndex - 1);
 
-    int lastApp = m_pageAppsModelList[m_pageIndex]->rowCount();
-    QModelIndex firstModel = m_appGridViewList[m_pageIndex]->indexAt(lastApp - 1);
-    m_appGridViewList[m_pageIndex]->dragIn(firstModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
+    AppGridView *currentView = pageView(m_pageIndex);
+    int lastApp = pageModel(m_pageIndex)->rowCount();
+    QModelIndex firstModel = currentView->indexAt(lastApp - 1);
+    currentView->dragIn(firstModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
 
     // 保存向左拖拽后item回归的终点位置
-    const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(firstModel).topLeft();
-    m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
+    const QPoint &dropCursorPoint = currentView->appIconRect(firstModel).topLeft();
+    currentView->setDropAndLastPos(dropCursorPoint);
 
     m_bDragStart = true;
 }
@@ -239,19 +166,21 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
     // 当前页面准备空出最后一个图标
     int newPos = m_calcUtil->appPageItemCount(m_category);
     // 下一页的末尾位置
-    m_appGridViewList[m_pageIndex]->dragOut(newPos * 2 - 1);
+    m_dragging = true;
+    pageView(m_pageIndex)->dragOut(newPos * 2 - 1);
 
     // 展开下一页
     showCurrentPage(m_pageIndex + 1);
 
     // 将最后一个App'挤走'
-    int lastApp = m_pageAppsModelList[m_pageIndex]->rowCount();
-    QModelIndex lastModel = m_appGridViewList[m_pageIndex]->indexAt(lastApp - 1);
-    m_appGridViewList[m_pageIndex]->dragIn(lastModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
+    AppGridView *currentView = pageView(m_pageIndex);
+    int lastApp = pageModel(m_pageIndex)->rowCount();
+    QModelIndex lastModel = currentView->indexAt(lastApp - 1);
+    currentView->dragIn(lastModel, m_pageSwitchAnimation->state() != QPropertyAnimation::Running);
 
     // 保存向右拖拽后item回归的终点位置
-    const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(lastModel).topLeft();
-    m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
+    const QPoint &dropCursorPoint = currentView->appIconRect(lastModel).topLeft();
+    currentView->setDropAndLastPos(dropCursorPoint);
 
     m_bDragStart = true;
 }
@@ -261,10 +190,16 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
  */
 void MultiPagesView::dragStop()
 {
-    if (sender() == m_appGridViewList[m_pageIndex])
+    // 拖拽源视图在 dragEnd 之后仍会继续处理, 等事件循环返回后再回收
+    if (m_dragging) {
+        m_dragging = false;
+        QTimer::singleShot(0, this, &MultiPagesView::recycleHiddenPages);
+    }
+
+    if (sender() == pageView(m_pageIndex))
         return;
 
-    m_appGridViewList[m_pageIndex]->flashDrag();
+    pageView(m_pageIndex)->flashDrag();
 }
 
 void MultiPagesView::updateAppDrawerTitle(const QModelIndex &index)
@@ -283,7 +218,7 @@ void MultiPagesView::updateAppDrawerTitle(const QModelIndex &index)
  */
 QModelIndex MultiPagesView::getAppItem(int index)
 {
-    return m_appGridViewList[m_pageIndex]->indexAt(index);
+    return pageView(m_pageIndex)->indexAt(index);
 }
 
 /**
@@ -302,13 +237,15 @@ void MultiPagesView::setDataDelegate(QAbstractItemDelegate *delegate)
 void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
 {
     int pageCount = m_appsManager->getPageCount(category);
-    for (int i = 0; i < qMax(pageCount, m_pageCount); i++) {
-        m_appGridViewList[i]->setVisible(i < pageCount);
-        m_pageAppsModelList[i]->setCategory(category);
-    }
+    for (AppGridView *pageView : m_pageViews)
+        qobject_cast<AppsListModel *>(pageView->model())->setCategory(category);
+
     m_pageControl->setPageCount(pageCount > 1 ? pageCount : 0);
     m_pageCount = pageCount;
     m_category = category;
+
+    recycleHiddenPages();
+    ensureVisiblePages();
 }
 
 /**
@@ -317,9 +254,10 @@ void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
  */
 void MultiPagesView::setModel(AppsListModel::AppCategory category)
 {
-    for (int i = 0; i < m_pageCount; i++) {
-        m_pageAppsModelList[i]->setCategory(category);
-        m_appGridViewList[i]->setModel(m_pageAppsModelList[i]);
+    for (AppGridView *pageView : m_pageViews) {
+        AppsListModel *pModel = qobject_cast<AppsListModel *>(pageView->model());
+        pModel->setCategory(category);
+        pageView->setModel(pModel);
     }
 }
 
@@ -335,14 +273,10 @@ void MultiPagesView::updatePosition(int mode)
     // TODO: 左右间隔，现在是根据剩余控件进行计算得出的，待优化
     int remainSpacing = m_calcUtil->appItemSpacing() * 7 / 2;
 
-    QSize tmpSize = size() - QSize(remainSpacing, m_pageControl->height() + DLauncher::DRAG_THRESHOLD);
-    m_appListArea->setFixedSize(tmpSize);
-    m_viewBox->setFixedSize(tmpSize);
+    m_pageSize = size() - QSize(remainSpacing, m_pageControl->height() + DLauncher::DRAG_THRESHOLD);
+    m_appListArea->setFixedSize(m_pageSize);
 
-    for (auto pView : m_appGridViewList)
-        pView->setFixedSize(tmpSize);
-    m_viewBox->layout()->setContentsMargins(0, 0, 0, 0);
-    m_viewBox->layout()->setSpacing(0);
+    layoutPages();
     m_pageControl->updateIconSize(m_calcUtil->getScreenScaleX(), m_calcUtil->getScreenScaleY());
 }
 
@@ -369,17 +303,189 @@ void MultiPagesView::initConnection()
 {
     connect(m_pageControl, &PageControl::onPageChanged, this, &MultiPagesView::showCurrentPage);
     connect(m_titleLabel, &EditLabel::titleChanged, this, &MultiPagesView::titleChanged);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished, this, [ = ] {
+        setGradientVisible(false);
+        stopPageSnapshots();
+        m_prerenderTimer->start();
+    });
+    connect(m_prerenderTimer, &QTimer::timeout, this, &MultiPagesView::prerenderPages);
+    // 翻页动画结束后, 回收离开可见范围的分页
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished, this, &MultiPagesView::recycleHiddenPages);
+}
+
+/**
+ * @brief MultiPagesView::createPageView 创建分页视图及其模型
+ * @return 新创建的分页视图
+ */
+AppGridView *MultiPagesView::createPageView()
+{
+    AppGridView *pageView = new AppGridView(m_viewType, m_viewBox);
+    AppsListModel *pModel = new AppsListModel(m_category, pageView);
+
+    pageView->setModel(pModel);
+    pageView->setItemDelegate(m_delegate);
+    pageView->setContainerBox(m_appListArea);
+    pageView->installEventFilter(this);
+    pageView->setDelegate(this);
+
+    connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
+    connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
+    connect(pageView, &AppGridView::requestScrollStop, [this] {
+        m_bDragStart = false;
+        setGradientVisible(false);
+    });
+    connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished, pageView, &AppGridView::setDragAnimationEnable);
+    emit connectViewEvent(pageView);
+
+    return pageView;
+}
+
+/**
+ * @brief MultiPagesView::materializePage 获取分页视图, 未实例化时复用回收的视图或创建新的视图
+ * @param page 分页索引
+ * @return 分页视图
+ */
+AppGridView *MultiPagesView::materializePage(int page)
+{
+    AppGridView *pageView = m_pageViews.value(page);
+    if (pageView)
+        return pageView;
+
+    pageView = m_recycledViews.isEmpty() ? createPageView() : m_recycledViews.takeLast();
+
+    AppsListModel *pModel = qobject_cast<AppsListModel *>(pageView->model());
+    if (pModel->category() != m_category)
+        pModel->setCategory(m_category);
+    pModel->setPageIndex(page);
+
+    m_pageViews.insert(page, pageView);
+
+    if (!m_pageSize.isEmpty()) {
+        pageView->setFixedSize(m_pageSize);
+        pageView->move(page * m_pageSize.width(), 0);
+    }
+    pageView->setVisible(true);
+
+    return pageView;
+}
+
+/**
+ * @brief MultiPagesView::ensureVisiblePages 实例化当前页及相邻的分页
+ */
+void MultiPagesView::ensureVisiblePages()
+{
+    const int current = qBound(0, m_pageIndex, m_pageCount - 1);
+    const int first = qMax(0, current - VISIBLE_PAGE_RANGE);
+    const int last = qMin(m_pageCount - 1, current + VISIBLE_PAGE_RANGE);
+
+    for (int page = first; page <= last; ++page)
+        materializePage(page);
+
+    layoutPages();
+    m_prerenderTimer->start();
+}
+
+/**
+ * @brief MultiPagesView::prerenderPages 空闲时将相邻分页渲染到图片中, 翻页动画直接滑动图片
+ */
+void MultiPagesView::prerenderPages()
+{
+    if (!isVisible() || m_pageSwitchAnimation->duration() == 0 || m_pageSwitchAnimation->state() == QPropertyAnimation::Running)
+        return;
+
+    for (auto it = m_pageViews.constBegin(); it != m_pageViews.constEnd(); ++it) {
+        if (it.key() != m_pageIndex)
+            it.value()->updateSnapshot();
+    }
+}
+
+/**
+ * @brief MultiPagesView::startPageSnapshots 翻页开始时所有分页改为绘制预先渲染的内容,
+ * 拖拽应用翻页时需要实时显示应用的移动动画, 不使用预先渲染的内容
+ * @param leavingPage 即将离开的分页, 可能有悬停等状态变化, 需要重新渲染
+ */
+void MultiPagesView::startPageSnapshots(int leavingPage)
+{
+    if (m_pageSnapshotEnabled || m_dragging || m_pageSwitchAnimation->duration() == 0)
+        return;
+
+    m_pageSnapshotEnabled = true;
+    for (auto it = m_pageViews.constBegin(); it != m_pageViews.constEnd(); ++it) {
+        it.value()->updateSnapshot(it.key() == leavingPage);
+        it.value()->setSnapshotEnabled(true);
+    }
+}
+
+/**
+ * @brief MultiPagesView::stopPageSnapshots 翻页结束后恢复实时绘制
+ */
+void MultiPagesView::stopPageSnapshots()
+{
+    if (!m_pageSnapshotEnabled)
+        return;
+
+    m_pageSnapshotEnabled = false;
+    for (AppGridView *pageView : m_pageViews)
+        pageView->setSnapshotEnabled(false);
+}
+
+/**
+ * @brief MultiPagesView::recycleHiddenPages 回收当前页及相邻页之外的分页视图,
+ * 拖拽过程中或翻页动画过程中不回收
+ */
+void MultiPagesView::recycleHiddenPages()
+{
+    if (m_dragging || m_pageSwitchAnimation->state() == QPropertyAnimation::Running)
+        return;
+
+    const int current = qBound(0, m_pageIndex, m_pageCount - 1);
+    for (auto it = m_pageViews.begin(); it != m_pageViews.end();) {
+        if (it.key() < m_pageCount && qAbs(it.key() - current) <= VISIBLE_PAGE_RANGE) {
+            ++it;
+            continue;
+        }
+
+        it.value()->setVisible(false);
+        it.value()->clearSnapshot();
+        m_recycledViews.append(it.value());
+        it = m_pageViews.erase(it);
+    }
+}
+
+/**
+ * @brief MultiPagesView::layoutPages 按分页索引摆放已实例化的视图, 容器宽度与分页数量一致
+ */
+void MultiPagesView::layoutPages()
+{
+    if (m_pageSize.isEmpty())
+        return;
+
+    m_viewBox->setFixedSize(m_pageSize.width() * qMax(1, m_pageCount), m_pageSize.height());
+
+    for (auto it = m_pageViews.constBegin(); it != m_pageViews.constEnd(); ++it) {
+        it.value()->setFixedSize(m_pageSize);
+        it.value()->move(it.key() * m_pageSize.width(), 0);
+    }
 }
 
 void MultiPagesView::showCurrentPage(int currentPage)
 {
+    const int leavingPage = m_pageIndex;
     m_pageIndex = ((currentPage > 0) ? (currentPage < m_pageCount ? currentPage : m_pageCount - 1) : 0);
-    int endValue = ((m_pageIndex == 0) ? 0 : (m_appGridViewList[m_pageIndex]->x()));
+    ensureVisiblePages();
+
+    int endValue = m_pageIndex * m_pageSize.width();
     int startValue = m_appListArea->horizontalScrollValue();
 
     m_appListArea->setProperty("curPage", m_pageIndex);
 
     m_pageSwitchAnimation->stop();
+    if (startValue != endValue)
+        startPageSnapshots(leavingPage);
+    else
+        stopPageSnapshots();
+
     m_pageSwitchAnimation->setStartValue(startValue);
     m_pageSwitchAnimation->setEndValue(endValue);
     m_pageSwitchAnimation->start();
@@ -400,7 +506,7 @@ QModelIndex MultiPagesView::selectApp(const int key)
             itemSelect = m_calcUtil->appPageItemCount(m_category) - 1;
         } else {
             page = m_pageCount - 1;
-            itemSelect = m_pageAppsModelList[page]->rowCount() - 1;
+            itemSelect = pageModel(page)->rowCount() - 1;
         }
     } else {
         if (page + 1 < m_pageCount) {
@@ -414,23 +520,24 @@ QModelIndex MultiPagesView::selectApp(const int key)
     if (page != m_pageIndex)
         showCurrentPage(page);
 
-    return m_appGridViewList[m_pageIndex]->indexAt(itemSelect);
+    return pageView(m_pageIndex)->indexAt(itemSelect);
 }
 
 AppGridView *MultiPagesView::pageView(int pageIndex)
 {
-    if (pageIndex >= m_pageCount)
+    if (pageIndex < 0 || pageIndex >= m_pageCount)
         return nullptr;
 
-    return m_appGridViewList[pageIndex];
+    return materializePage(pageIndex);
 }
 
 AppsListModel *MultiPagesView::pageModel(int pageIndex)
 {
-    if (pageIndex >= m_pageCount)
+    AppGridView *view = pageView(pageIndex);
+    if (!view)
         return nullptr;
 
-    return m_pageAppsModelList[pageIndex];
+    return qobject_cast<AppsListModel *>(view->model());
 }
 
 void MultiPagesView::wheelEvent(QWheelEvent *e)
@@ -477,6 +584,10 @@ void MultiPagesView::mouseMove(QMouseEvent *e)
     int nDiff = m_nMousePos - e->x();
     m_scrollValue += nDiff;
 
+    // 手指拖动翻页时同样滑动预先渲染的内容
+    if (m_pageCount > 1 && m_scrollValue != m_scrollStart)
+        startPageSnapshots(m_pageIndex);
+
     m_appListArea->setHorizontalScrollValue(m_scrollValue);
 
     if(m_pageCount == 1)
@@ -505,8 +616,8 @@ void MultiPagesView::mouseRelease(QMouseEvent *e)
     setGradientVisible(false);
 
     // 移动完成后，更新状态
-    if ((m_pageIndex >= 0) && (m_pageIndex <= m_appGridViewList.size() - 1))
-        m_appGridViewList[m_pageIndex]->setViewMoveState(false);
+    if (AppGridView *currentView = m_pageViews.value(m_pageIndex))
+        currentView->setViewMoveState(false);
 }
 
 void MultiPagesView::setGradientVisible(bool visible)
@@ -558,7 +669,7 @@ AppListArea *MultiPagesView::getListArea()
 
 AppGridViewList MultiPagesView::getAppGridViewList()
 {
-    return m_appGridViewList;
+    return m_pageViews.values();
 }
 
 AppsListModel::AppCategory MultiPagesView::getCategory()
@@ -568,7 +679,6 @@ AppsListModel::AppCategory MultiPagesView::getCategory()
 
 QSize MultiPagesView::calculateWidgetSize()
 {
-    const AppGridViewList &viewList = m_appGridViewList;
     QSize itemSize = CalculateUtil::instance()->appItemSize() * 5 / 4;
 
     int leftMargin = CalculateUtil::instance()->appMarginLeft();
@@ -577,11 +687,10 @@ QSize MultiPagesView::calculateWidgetSize()
     int itemHeight = itemSize.height();
     int viewWidth;
     int viewHeight = itemHeight * 3;
-    if (viewList.size() > 1) {
+    if (m_pageCount > 1) {
         viewWidth = itemWidth * 4;
     } else {
-        AppGridView *view = viewList.at(0);
-        AppsListModel *listModel = qobject_cast<AppsListModel *>(view->model());
+        AppsListModel *listModel = pageModel(0);
 
         if (!listModel)
             return QSize();
@@ -601,17 +710,6 @@ QSize MultiPagesView::calculateWidgetSize()
     return QSize(viewWidth, viewHeight);
 }
 
-// 更新边框渐变，在屏幕变化时需要更新，类别拖动时需要隐藏
-void MultiPagesView::updateGradient()
-{
-    QWidget *backgroundWidget = getParentWidget();
-    if (!backgroundWidget)
-        return;
-
-    QPixmap background = backgroundWidget->grab();
-    updateGradient(background, calculPadding(MultiPagesView::Left), calculPadding(MultiPagesView::Right));
-}
-
 bool MultiPagesView::isScrolling()
 {
     if (m_changePageDelayTime)
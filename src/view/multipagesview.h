@@ -64,8 +64,6 @@ public:
     void mouseRelease(QMouseEvent *e) override;
 
     void setGradientVisible(bool visible);
-    void updateGradient();
-    void updateGradient(QPixmap& pixmap, QPoint startPoint, QPoint topRightImg);
 
     QPropertyAnimation::State getPageSwitchAnimationState();
     QWidget *getParentWidget();
@@ -88,11 +86,20 @@ private slots:
     void dragToLeft(const QModelIndex &index);
     void dragToRight(const QModelIndex &index);
     void dragStop();
+    void recycleHiddenPages();
+    void prerenderPages();
 
 private:
     void initUi();
     void initConnection();
 
+    AppGridView *createPageView();
+    AppGridView *materializePage(int page);
+    void ensureVisiblePages();
+    void layoutPages();
+    void startPageSnapshots(int leavingPage);
+    void stopPageSnapshots();
+
 protected:
     void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
     void showEvent(QShowEvent *e) Q_DECL_OVERRIDE;
@@ -104,12 +111,16 @@ private:
     AppsManager *m_appsManager;                         // 应用管理类
     CalculateUtil *m_calcUtil;                          // 界面布局计算类
     AppListArea *m_appListArea;                         // 滑动区域控件
-    AppGridViewList m_appGridViewList;                  // 多视图列表
-    PageAppsModelist m_pageAppsModelList;               // 多视图模型列表
+    QMap<int, AppGridView *> m_pageViews;               // 已实例化的分页视图, 只保留当前页及相邻页
+    AppGridViewList m_recycledViews;                    // 回收待复用的视图
+    AppGridView::ViewType m_viewType;                   // 分页视图类型
 
-    DHBoxWidget *m_viewBox;
+    QWidget *m_viewBox;                                 // 分页视图容器, 宽度为所有分页宽度之和
+    QSize m_pageSize;                                   // 单个分页的大小
 
     QPropertyAnimation *m_pageSwitchAnimation;          // 分页切换动画
+    QTimer *m_prerenderTimer;                           // 空闲时预先渲染相邻分页
+    bool m_pageSnapshotEnabled;                         // 翻页过程中分页是否使用预先渲染的内容
 
     QAbstractItemDelegate *m_delegate;                  // 视图代理基类
     EditLabel *m_titleLabel;
@@ -120,6 +131,7 @@ private:
     int m_pageIndex;
 
     bool m_bDragStart;
+    bool m_dragging;                                    // 拖拽应用触发了分页, 拖拽结束前不回收视图
     bool m_bMousePress;
     int m_nMousePos;
     int m_scrollValue;
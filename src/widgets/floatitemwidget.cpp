@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "floatitemwidget.h"
+
+#include <QAbstractItemView>
+#include <QPainter>
+
+FloatItemWidget::FloatItemWidget(QAbstractItemView *view, QWidget *parent)
+    : QWidget(parent)
+    , m_view(view)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+/**
+ * @brief FloatItemWidget::setIndex 设置需要显示的应用
+ * @param index 应用对应的模型索引
+ * @param size 应用的大小
+ */
+void FloatItemWidget::setIndex(const QModelIndex &index, const QSize &size)
+{
+    m_index = index;
+    setFixedSize(size);
+    update();
+}
+
+void FloatItemWidget::paintEvent(QPaintEvent *e)
+{
+    Q_UNUSED(e);
+
+    if (!m_view || !m_view->itemDelegate() || !m_index.isValid())
+        return;
+
+    QStyleOptionViewItem item;
+    item.rect = rect();
+    item.features |= QStyleOptionViewItem::HasDisplay;
+
+    QPainter painter(this);
+    m_view->itemDelegate()->paint(&painter, item, m_index);
+}
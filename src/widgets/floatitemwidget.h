@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FLOATITEMWIDGET_H
+#define FLOATITEMWIDGET_H
+
+#include <QWidget>
+#include <QPersistentModelIndex>
+
+class QAbstractItemView;
+
+/**
+ * @brief The FloatItemWidget class
+ * 拖拽交换位置时移动的应用图标, 直接由视图代理绘制(命中代理的图块缓存), 不再为每次移动生成图片
+ */
+class FloatItemWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FloatItemWidget(QAbstractItemView *view, QWidget *parent = nullptr);
+
+    void setIndex(const QModelIndex &index, const QSize &size);
+
+protected:
+    void paintEvent(QPaintEvent *e) override;
+
+private:
+    QAbstractItemView *m_view;
+    QPersistentModelIndex m_index;
+};
+
+#endif // FLOATITEMWIDGET_H
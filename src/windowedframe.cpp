@@ -97,7 +97,7 @@ WindowedFrame::WindowedFrame(QWidget *parent)
     , m_modeSwitch(new ModeSwitch(this))
     , m_isSearching(false)
 {
-    if (!ConfigWorker::getValue(DLauncher::ENABLE_FULL_SCREEN_MODE, true).toBool())
+    if (!ConfigWorker::snapshot()->enableFullScreenMode)
         m_modeToggleBtn->hide();
 
     initUi();
@@ -354,7 +354,7 @@ void WindowedFrame::initConnection()
     connect(m_favoriteView, &AppGridView::entered, this, &WindowedFrame::onHandleHoverAction);
     connect(m_favoriteView, &AppGridView::popupMenuRequested, m_menuWorker.get(), &MenuWorker::showMenuByAppItem);
     connect(m_favoriteModel, &QAbstractItemModel::dataChanged, this, &WindowedFrame::onFavoriteListVisibleChaged);
-    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, m_favoriteView, qOverload<>(&AppGridView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, m_favoriteView, qOverload<const QModelIndex &>(&AppGridView::update));
 
     // 所有应用
     connect(m_allAppView, &AppGridView::clicked, m_appsManager, &AppsManager::launchApp, Qt::QueuedConnection);
@@ -363,7 +363,7 @@ void WindowedFrame::initConnection()
     connect(m_allAppView, &AppGridView::entered, this, &WindowedFrame::onEnterView);
     connect(m_allAppView, &AppGridView::entered, this, &WindowedFrame::onHandleHoverAction);
     connect(m_allAppView, &AppGridView::popupMenuRequested, m_menuWorker.get(), &MenuWorker::showMenuByAppItem);
-    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, m_allAppView, qOverload<>(&AppGridView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, m_allAppView, qOverload<const QModelIndex &>(&AppGridView::update));
 
     // 搜索页面
     connect(m_searchWidget, &SearchModeWidget::connectViewEvent, this , &WindowedFrame::addViewEvent);
@@ -1455,7 +1455,7 @@ void WindowedFrame::addViewEvent(AppGridView *pView)
     connect(pView, &AppGridView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
     connect(pView, &AppGridView::entered, this, &WindowedFrame::onHandleHoverAction);
     connect(pView, &AppGridView::popupMenuRequested, m_menuWorker.get(), &MenuWorker::showMenuByAppItem);
-    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<>(&AppGridView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::requestUpdate, pView, qOverload<const QModelIndex &>(&AppGridView::update));
 }
 
 void WindowedFrame::onButtonClick(int buttonid)
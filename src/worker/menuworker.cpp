@@ -43,31 +43,33 @@ MenuWorker::~MenuWorker()
 
 void MenuWorker::creatMenuByAppItem()
 {
-    m_appKey = m_currentModelIndex.data(AppsListModel::AppKeyRole).toString();
-    m_appDesktop = m_currentModelIndex.data(AppsListModel::AppDesktopRole).toString();
-    m_isItemOnDesktop = m_currentModelIndex.data(AppsListModel::AppIsOnDesktopRole).toBool();
-    m_isItemOnDock = m_currentModelIndex.data(AppsListModel::AppIsOnDockRole).toBool();
-    m_isItemStartup = m_currentModelIndex.data(AppsListModel::AppAutoStartRole).toBool();
-    m_isItemProxy = m_currentModelIndex.data(AppsListModel::AppIsProxyRole).toBool();
-    m_isItemEnableScaling = m_currentModelIndex.data(AppsListModel::AppEnableScalingRole).toBool();
-    m_isItemInCollected = m_currentModelIndex.data(AppsListModel::AppIsInFavoriteRole).toBool();
+    // 一次获取创建菜单所需的数据, 避免多次查找同一个应用
+    const AppMenuInfo menuInfo = m_currentModelIndex.data(AppsListModel::AppMenuInfoRole).value<AppMenuInfo>();
+    m_appKey = menuInfo.key;
+    m_appDesktop = menuInfo.desktop;
+    m_isItemOnDesktop = menuInfo.isOnDesktop;
+    m_isItemOnDock = menuInfo.isOnDock;
+    m_isItemStartup = menuInfo.autoStart;
+    m_isItemProxy = menuInfo.isProxy;
+    m_isItemEnableScaling = menuInfo.enableScaling;
+    m_isItemInCollected = menuInfo.isInFavorite;
 
     const double scale_ratio = SettingValue("com.deepin.xsettings", QByteArray(), "scale-factor", 1.0).toDouble();;
 
-    const bool isRemovable = m_currentModelIndex.data(AppsListModel::AppIsRemovableRole).toBool();
-    const bool hideOpen = m_currentModelIndex.data(AppsListModel::AppHideOpenRole).toBool();
-    const bool hideSendToDesktop = m_currentModelIndex.data(AppsListModel::AppHideSendToDesktopRole).toBool();
-    const bool hideSendToDock = m_currentModelIndex.data(AppsListModel::AppHideSendToDockRole).toBool();
-    const bool hideStartUp = m_currentModelIndex.data(AppsListModel::AppHideStartUpRole).toBool();
-    const bool hideUninstall = m_currentModelIndex.data(AppsListModel::AppHideUninstallRole).toBool();
-    const bool hideUseProxy = m_currentModelIndex.data(AppsListModel::AppHideUseProxyRole).toBool();
-    const bool canOpen = m_currentModelIndex.data(AppsListModel::AppCanOpenRole).toBool();
-    const bool canSendToDesktop = m_currentModelIndex.data(AppsListModel::AppCanSendToDesktopRole).toBool();
-    const bool canSendToDock = m_currentModelIndex.data(AppsListModel::AppCanSendToDockRole).toBool();
-    const bool canStartUp = m_currentModelIndex.data(AppsListModel::AppCanStartUpRole).toBool();
+    const bool isRemovable = menuInfo.isRemovable;
+    const bool hideOpen = menuInfo.hideOpen;
+    const bool hideSendToDesktop = menuInfo.hideSendToDesktop;
+    const bool hideSendToDock = menuInfo.hideSendToDock;
+    const bool hideStartUp = menuInfo.hideStartUp;
+    const bool hideUninstall = menuInfo.hideUninstall;
+    const bool hideUseProxy = menuInfo.hideUseProxy;
+    const bool canOpen = menuInfo.canOpen;
+    const bool canSendToDesktop = menuInfo.canSendToDesktop;
+    const bool canSendToDock = menuInfo.canSendToDock;
+    const bool canStartUp = menuInfo.canStartUp;
     const bool canDisableScale = m_calcUtil->IsServerSystem || qFuzzyCompare(1.0, scale_ratio);
-    const bool canUseProxy = m_currentModelIndex.data(AppsListModel::AppCanOpenProxyRole).toBool();
-    const bool isInCollectedList = m_currentModelIndex.data(AppsListModel::AppIsInFavoriteRole).toBool();
+    const bool canUseProxy = menuInfo.canUseProxy;
+    const bool isInCollectedList = menuInfo.isInFavorite;
     const bool isTopInCollectList = (m_currentModelIndex.row() == 0);
     const bool canMoveToTop = (m_currentModelIndex.row() != 0);
     bool onlyShownInCollectedList = false;
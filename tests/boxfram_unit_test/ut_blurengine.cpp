@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "blurengine.h"
+
+#include <QTest>
+#include <QVector>
+
+#include <gtest/gtest.h>
+
+class Tst_BlurEngine : public testing::Test
+{
+};
+
+/**
+ * @brief referenceBlur 逐像素求平均的盒式模糊, 作为对照结果
+ * @param image 预乘格式的图片
+ * @param radius 模糊半径
+ * @param passes 模糊次数
+ * @return 每个像素4个通道的结果
+ */
+static QVector<int> referenceBlur(const QImage &image, const int radius, const int passes)
+{
+    const int width = image.width();
+    const int height = image.height();
+    QVector<int> pixels(width * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const quint32 *line = reinterpret_cast<const quint32 *>(image.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 4; ++c)
+                pixels[(y * width + x) * 4 + c] = (line[x] >> (c * 8)) & 0xff;
+        }
+    }
+
+    auto blurLine = [ & ](bool horizontal) {
+        QVector<int> result(pixels.size());
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < 4; ++c) {
+                    int sum = 0;
+                    for (int i = -radius; i <= radius; ++i) {
+                        const int sx = horizontal ? qBound(0, x + i, width - 1) : x;
+                        const int sy = horizontal ? y : qBound(0, y + i, height - 1);
+                        sum += pixels[(sy * width + sx) * 4 + c];
+                    }
+                    result[(y * width + x) * 4 + c] = qRound(qreal(sum) / (radius * 2 + 1));
+                }
+            }
+        }
+        pixels = result;
+    };
+
+    for (int pass = 0; pass < passes; ++pass) {
+        blurLine(true);
+        blurLine(false);
+    }
+
+    return pixels;
+}
+
+TEST_F(Tst_BlurEngine, blur_test)
+{
+    // 宽高不同且宽度不是4的倍数, 覆盖行、列步长不一致的情况
+    const int width = 37;
+    const int height = 19;
+    const int radius = 4;
+
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int alpha = (x * 7 + y * 13) % 256;
+            image.setPixel(x, y, qRgba((x * 31) % (alpha + 1), (y * 17) % (alpha + 1), ((x + y) * 5) % (alpha + 1), alpha));
+        }
+    }
+
+    const QImage result = BlurEngine::blur(image, radius);
+    QCOMPARE(result.size(), image.size());
+
+    // 各平台 SIMD 取整方式不同, 每次模糊最多相差 1
+    const QVector<int> reference = referenceBlur(image, radius, 3);
+    int maxDiff = 0;
+    for (int y = 0; y < height; ++y) {
+        const quint32 *line = reinterpret_cast<const quint32 *>(result.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                const int value = (line[x] >> (c * 8)) & 0xff;
+                maxDiff = qMax(maxDiff, qAbs(value - reference[(y * width + x) * 4 + c]));
+            }
+        }
+    }
+
+    QVERIFY(maxDiff <= 3);
+}
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stringpool.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_StringPool : public testing::Test
+{
+};
+
+TEST_F(Tst_StringPool, intern_test)
+{
+    const QString desktop1 = StringPool::intern(QString("/usr/share/applications/%1.desktop").arg("dde-file-manager"));
+    const QString desktop2 = StringPool::intern(QString("/usr/share/applications/dde-file-manager.desktop"));
+    const QString desktop3 = StringPool::intern(QString("/usr/share/applications/dde-control-center.desktop"));
+
+    // 内容相同的字符串驻留后共享数据
+    QVERIFY(desktop1.constData() == desktop2.constData());
+    QVERIFY(desktop1.constData() != desktop3.constData());
+
+    QVERIFY(StringPool::intern(QString()).isEmpty());
+}
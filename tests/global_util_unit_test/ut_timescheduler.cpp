@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define private public
+#include "timescheduler.h"
+#undef private
+
+#include <QDateTime>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_TimeScheduler : public testing::Test
+{
+};
+
+TEST_F(Tst_TimeScheduler, wakeupsPerHour_test)
+{
+    TimeScheduler *scheduler = TimeScheduler::instance();
+    scheduler->m_wakeupTimes.clear();
+
+    qint64 now = 0;
+    scheduler->setClock([ &now ] { return now; });
+
+    const qint64 minute = 60 * 1000;
+    scheduler->recordWakeup();
+    now += 30 * minute;
+    scheduler->recordWakeup();
+    QCOMPARE(scheduler->wakeupsPerHour(), 2);
+
+    // 查询不修改记录, 超过一小时的唤醒不再计入
+    now += 31 * minute;
+    QCOMPARE(scheduler->wakeupsPerHour(), 1);
+    QCOMPARE(scheduler->wakeupsPerHour(), 1);
+    QCOMPARE(scheduler->m_wakeupTimes.size(), 2);
+
+    // 记录新的唤醒时清理一小时之前的记录
+    scheduler->recordWakeup();
+    QCOMPARE(scheduler->m_wakeupTimes.size(), 2);
+    QCOMPARE(scheduler->wakeupsPerHour(), 2);
+
+    now += 2 * 60 * minute;
+    QCOMPARE(scheduler->wakeupsPerHour(), 0);
+
+    scheduler->m_wakeupTimes.clear();
+    scheduler->setClock(&QDateTime::currentMSecsSinceEpoch);
+}
@@ -5,6 +5,7 @@
 #include "util.h"
 
 #include <QSize>
+#include <QPixmap>
 #include <QTest>
 
 #include <gtest/gtest.h>
@@ -31,3 +32,22 @@ TEST_F(Tst_Util, settingsPtr_test)
 {
     QVERIFY(ModuleSettingsPtr("", "", nullptr) == nullptr);
 }
+
+TEST_F(Tst_Util, calendarIcon_test)
+{
+    const QPixmap pix = calendarIcon(64, 1.0);
+    QVERIFY(!pix.isNull());
+    QVERIFY(pix.size() == QSize(64, 64));
+
+    // 同一天内相同尺寸复用缓存
+    QVERIFY(calendarIcon(64, 1.0).cacheKey() == pix.cacheKey());
+}
+
+TEST_F(Tst_Util, configSnapshot_test)
+{
+    QSharedPointer<const ConfigSnapshot> snapshot = ConfigWorker::snapshot();
+    QVERIFY(!snapshot.isNull());
+
+    // 配置未变化时复用同一份快照
+    QVERIFY(ConfigWorker::snapshot() == snapshot);
+}
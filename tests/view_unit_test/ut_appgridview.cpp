@@ -12,6 +12,7 @@
 #include <QApplication>
 #include <QDropEvent>
 #include <QDragEnterEvent>
+#include <QSignalSpy>
 #include <QTest>
 
 #include <gtest/gtest.h>
@@ -112,6 +113,23 @@ TEST_F(Tst_Appgridview, listModel_test)
     }
 }
 
+TEST_F(Tst_Appgridview, moveRows_test)
+{
+    AppsListModel appsListModel(AppsListModel::FullscreenAll);
+    QSignalSpy aboutToMoveSpy(&appsListModel, SIGNAL(rowsAboutToBeMoved(QModelIndex, int, int, QModelIndex, int)));
+    QSignalSpy movedSpy(&appsListModel, SIGNAL(rowsMoved(QModelIndex, int, int, QModelIndex, int)));
+
+    // 无效的位置不修改列表, 也不通知视图
+    const int rows = appsListModel.rowCount();
+    QVERIFY(!appsListModel.moveRows(QModelIndex(), rows, 1, QModelIndex(), 0));
+    QVERIFY(!appsListModel.moveRows(QModelIndex(), -1, 1, QModelIndex(), 0));
+    QCOMPARE(aboutToMoveSpy.count(), 0);
+    QCOMPARE(movedSpy.count(), 0);
+
+    // 没有打开的文件夹时, 文件夹内不能移动
+    QVERIFY(!AppsManager::instance()->canMoveItem(AppsListModel::Dir, 0, 0));
+}
+
 TEST_F(Tst_Appgridview, itemDelegate_test)
 {
     AppItemDelegate delegate(m_widget);
@@ -121,3 +139,27 @@ TEST_F(Tst_Appgridview, itemDelegate_test)
     QRect boundRect(QPoint(10, 10), QSize(20, 20));
     delegate.itemTextRect(boundRect, boundRect, true);
 }
+
+TEST_F(Tst_Appgridview, dirTileCache_test)
+{
+    AppItemDelegate delegate(m_widget);
+    delegate.m_tileCache.clear();
+
+    ItemInfo_v1 childInfo;
+    childInfo.m_desktop = QString("/usr/share/applications/deepin-editor.desktop");
+
+    const ItemLayoutKey layoutKey { QString("test"), QSize(100, 100), QSize(60, 60), QString(), false };
+    const ItemTileKey appKey { layoutKey, childInfo.m_desktop, QString(), QStringList(), false, true, 1 };
+    const ItemTileKey dirKey { layoutKey, QString("dir"), QString(), QStringList() << childInfo.m_desktop, false, true, 1 };
+    const ItemTileKey otherKey { layoutKey, QString("/usr/share/applications/dde-calendar.desktop"), QString(), QStringList(), false, true, 1 };
+    delegate.m_tileCache.insert(appKey, new QPixmap(1, 1), 4);
+    delegate.m_tileCache.insert(dirKey, new QPixmap(1, 1), 4);
+    delegate.m_tileCache.insert(otherKey, new QPixmap(1, 1), 4);
+
+    // 文件夹中的应用变化后, 文件夹的绘制结果需要重新生成
+    delegate.removeItemCache(childInfo);
+
+    QVERIFY(!delegate.m_tileCache.contains(appKey));
+    QVERIFY(!delegate.m_tileCache.contains(dirKey));
+    QVERIFY(delegate.m_tileCache.contains(otherKey));
+}
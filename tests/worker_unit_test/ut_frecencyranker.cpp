@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "frecencyranker.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_FrecencyRanker : public testing::Test
+{
+};
+
+TEST_F(Tst_FrecencyRanker, rank_test)
+{
+    const qint64 day = 24 * 3600;
+    const QString fileManager("/usr/share/applications/dde-file-manager.desktop");
+    const QString controlCenter("/usr/share/applications/dde-control-center.desktop");
+    const QString terminal("/usr/share/applications/deepin-terminal.desktop");
+
+    FrecencyRanker ranker(day);
+    ranker.recordLaunch(fileManager, 0);
+    ranker.recordLaunch(fileManager, 0);
+    ranker.recordLaunch(fileManager, 0);
+    ranker.recordLaunch(controlCenter, 0);
+    QCOMPARE(ranker.topApps(-1), QStringList({ fileManager, controlCenter }));
+
+    // 分值随时间衰减, 最近启动的应用排在前面
+    ranker.recordLaunch(terminal, 3 * day);
+    ranker.recordLaunch(terminal, 3 * day);
+    QCOMPARE(ranker.topApps(1), QStringList({ terminal }));
+    QVERIFY(qAbs(ranker.score(fileManager, day) - 1.5) < 1e-6);
+
+    FrecencyRanker restored(day);
+    restored.fromVariantMap(ranker.toVariantMap());
+    QCOMPARE(restored.topApps(-1), ranker.topApps(-1));
+
+    restored.remove(terminal);
+    QVERIFY(!restored.contains(terminal));
+    QCOMPARE(restored.size(), 2);
+}